@@ -0,0 +1,121 @@
+#include "stdafx.h"
+#include "AILevelOfDetail.h"
+#include "TickScheduler.h"
+#include "ConfigManager.h"
+#include "DebugOutputManager.h"
+
+namespace
+{
+	// Weight of the newest frame in the average, smooths out single slow frames
+	const float AverageCostWeight = .1f;
+
+	// Per tier settings, indexed by LODTier
+	const float PlannerIntervalScales[] = { 1.f, 2.f, 4.f };
+	const float NavigationIntervalScales[] = { 1.f, 1.5f, 2.f };
+	const float ScoutProbeScales[] = { 1.f, .5f, .25f };
+	const int PurgeZoneCheckStrides[] = { 1, 2, 4 };
+}
+
+AILevelOfDetail::AILevelOfDetail(TickScheduler* pScheduler) :
+	m_pScheduler(pScheduler)
+{
+}
+
+void AILevelOfDetail::EndFrame(float frameCostMs, float deltaTime)
+{
+	ConfigManager* pConfig = ConfigManager::GetInstance();
+
+	m_AverageCost += (frameCostMs - m_AverageCost) * AverageCostWeight;
+	m_TierTimer += deltaTime;
+	m_TimeInTier[static_cast<int>(m_Tier)] += deltaTime;
+
+	// Give the average time to settle in the current tier before changing again
+	if (m_TierTimer >= pConfig->GetLODMinTierDuration())
+	{
+		float budget = pConfig->GetAIFrameBudget();
+		int tier = static_cast<int>(m_Tier);
+		if (m_AverageCost > budget && tier < static_cast<int>(LODTier::COUNT) - 1)
+			SetTier(static_cast<LODTier>(tier + 1));
+		else if (m_AverageCost < budget * pConfig->GetLODStepUpRatio() && tier > 0)
+			SetTier(static_cast<LODTier>(tier - 1));
+	}
+
+	float reportInterval = pConfig->GetLODReportInterval();
+	m_ReportTimer += deltaTime;
+	if (reportInterval > 0.f && m_ReportTimer >= reportInterval)
+	{
+		Report();
+		m_ReportTimer = 0.f;
+	}
+}
+
+float AILevelOfDetail::GetScoutProbeScale() const
+{
+	return ScoutProbeScales[static_cast<int>(m_Tier)];
+}
+
+int AILevelOfDetail::GetPurgeZoneCheckStride() const
+{
+	return PurgeZoneCheckStrides[static_cast<int>(m_Tier)];
+}
+
+bool AILevelOfDetail::AllowDebugDraw() const
+{
+	return m_Tier == LODTier::FULL;
+}
+
+const char* AILevelOfDetail::GetTierName(LODTier tier)
+{
+	switch (tier)
+	{
+	case LODTier::FULL:
+		return "Full";
+	case LODTier::REDUCED:
+		return "Reduced";
+	case LODTier::MINIMAL:
+		return "Minimal";
+	default:
+		return "Unknown";
+	}
+}
+
+void AILevelOfDetail::SetTier(LODTier tier)
+{
+	if (DebugOutputManager::GetInstance()->IsDebugTypeEnabled(DebugOutputManager::DebugType::LEVEL_OF_DETAIL))
+	{
+		char line[128];
+		snprintf(line, sizeof(line), "AI LOD %s -> %s, average update %.3f ms, budget %.3f ms\n",
+			GetTierName(m_Tier), GetTierName(tier), m_AverageCost, ConfigManager::GetInstance()->GetAIFrameBudget());
+		DebugOutputManager::GetInstance()->DebugLine(line, DebugOutputManager::DebugType::LEVEL_OF_DETAIL);
+	}
+
+	m_Tier = tier;
+	m_TierTimer = 0.f;
+	++m_TierChanges;
+
+	if (m_pScheduler)
+	{
+		int tierIndex = static_cast<int>(tier);
+		m_pScheduler->SetIntervalScale(ScheduledTask::PLANNER, PlannerIntervalScales[tierIndex]);
+		m_pScheduler->SetIntervalScale(ScheduledTask::NAVMESH_REFRESH, NavigationIntervalScales[tierIndex]);
+		m_pScheduler->SetIntervalScale(ScheduledTask::SEEK_LOCATION, NavigationIntervalScales[tierIndex]);
+	}
+}
+
+void AILevelOfDetail::Report()
+{
+	if (DebugOutputManager::GetInstance()->IsDebugTypeEnabled(DebugOutputManager::DebugType::LEVEL_OF_DETAIL))
+	{
+		char line[192];
+		snprintf(line, sizeof(line), "AI LOD time per tier: full %.1f s, reduced %.1f s, minimal %.1f s, %d tier changes\n",
+			m_TimeInTier[static_cast<int>(LODTier::FULL)], m_TimeInTier[static_cast<int>(LODTier::REDUCED)],
+			m_TimeInTier[static_cast<int>(LODTier::MINIMAL)], m_TierChanges);
+		DebugOutputManager::GetInstance()->DebugLine(line, DebugOutputManager::DebugType::LEVEL_OF_DETAIL);
+	}
+
+	for (float& time : m_TimeInTier)
+	{
+		time = 0.f;
+	}
+	m_TierChanges = 0;
+}
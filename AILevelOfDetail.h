@@ -0,0 +1,45 @@
+#pragma once
+
+class TickScheduler;
+
+// Detail tiers, every step down trades decision quality for frame time
+enum class LODTier
+{
+	FULL,
+	REDUCED,
+	MINIMAL,
+	COUNT
+};
+
+// Keeps the agent's update within the frame budget from the ConfigManager
+// Steps down a tier while the smoothed update cost is over budget and back up once there is headroom again
+class AILevelOfDetail final
+{
+public:
+	explicit AILevelOfDetail(TickScheduler* pScheduler);
+
+	// Feed the measured cost of the agent's update at the end of every frame
+	void EndFrame(float frameCostMs, float deltaTime);
+
+	LODTier GetTier() const { return m_Tier; };
+	float GetAverageCost() const { return m_AverageCost; };
+
+	// Tier dependent settings
+	float GetScoutProbeScale() const;
+	int GetPurgeZoneCheckStride() const;
+	bool AllowDebugDraw() const;
+
+	static const char* GetTierName(LODTier tier);
+private:
+	TickScheduler* m_pScheduler = nullptr; // Not owned, planner and navmesh rates are scaled per tier
+
+	LODTier m_Tier{ LODTier::FULL };
+	float m_AverageCost{ 0.f }; // Exponential moving average in ms
+	float m_TierTimer{ 0.f }; // Time since the last tier change, a tier is kept for a minimum duration
+	float m_TimeInTier[static_cast<int>(LODTier::COUNT)]{};
+	int m_TierChanges{ 0 };
+	float m_ReportTimer{ 0.f };
+
+	void SetTier(LODTier tier);
+	void Report();
+};
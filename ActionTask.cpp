@@ -0,0 +1,120 @@
+#include "stdafx.h"
+#include "ActionTask.h"
+
+// ---------------------------
+// ActionFramePool
+ActionFramePool* ActionFramePool::instance = 0;
+
+ActionFramePool::~ActionFramePool()
+{
+	for (FreeFrame*& pFreeList : m_pFreeLists)
+	{
+		while (pFreeList)
+		{
+			FreeFrame* pNext = pFreeList->pNext;
+			::operator delete(pFreeList);
+			pFreeList = pNext;
+		}
+	}
+}
+
+void* ActionFramePool::Allocate(size_t size)
+{
+	int sizeClass = GetSizeClass(size);
+	if (sizeClass < 0)
+	{
+		++m_HeapFrameCount;
+		return ::operator new(size);
+	}
+
+	FreeFrame*& pFreeList = m_pFreeLists[sizeClass];
+	if (pFreeList)
+	{
+		FreeFrame* pFrame = pFreeList;
+		pFreeList = pFrame->pNext;
+		return pFrame;
+	}
+
+	++m_PooledFrameCount;
+	return ::operator new(SmallestSizeClass << sizeClass);
+}
+
+void ActionFramePool::Deallocate(void* pFrame, size_t size)
+{
+	int sizeClass = GetSizeClass(size);
+	if (sizeClass < 0)
+	{
+		::operator delete(pFrame);
+		return;
+	}
+
+	// Keep the frame for the next coroutine of the same size class
+	FreeFrame* pFreeFrame = static_cast<FreeFrame*>(pFrame);
+	pFreeFrame->pNext = m_pFreeLists[sizeClass];
+	m_pFreeLists[sizeClass] = pFreeFrame;
+}
+
+int ActionFramePool::GetSizeClass(size_t size)
+{
+	size_t classSize = SmallestSizeClass;
+	for (int sizeClass{ 0 }; sizeClass < static_cast<int>(SizeClassCount); ++sizeClass)
+	{
+		if (size <= classSize)
+			return sizeClass;
+		classSize <<= 1;
+	}
+	return -1;
+}
+
+// ---------------------------
+// ActionTask
+ActionTask::~ActionTask()
+{
+	if (m_Handle)
+		m_Handle.destroy();
+}
+
+ActionTask::ActionTask(ActionTask&& other) noexcept :
+	m_Handle(std::exchange(other.m_Handle, {}))
+{
+}
+
+ActionTask& ActionTask::operator=(ActionTask&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (m_Handle)
+			m_Handle.destroy();
+		m_Handle = std::exchange(other.m_Handle, {});
+	}
+	return *this;
+}
+
+bool ActionTask::Tick(float deltaTime)
+{
+	if (!m_Handle)
+		return true;
+	if (m_Handle.done())
+		return true;
+
+	m_Handle.promise().time += deltaTime;
+	if (IsAwake())
+		m_Handle.resume();
+
+	return m_Handle.done();
+}
+
+bool ActionTask::IsAwake() const
+{
+	const promise_type& promise = m_Handle.promise();
+	switch (promise.wakeCondition)
+	{
+	case WakeCondition::TIME:
+		return promise.time >= promise.wakeTime;
+	case WakeCondition::PREDICATE:
+		return promise.pPredicate(promise.pPredicateData);
+	case WakeCondition::NEXT_FRAME:
+	default:
+		return true;
+	}
+}
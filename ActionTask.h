@@ -0,0 +1,157 @@
+#pragma once
+/*=============================================================================*/
+// ActionTask.h: Coroutine execution model for GOAP actions
+// An action returning an ActionTask can co_await NextFrame, WaitSeconds or WaitUntil
+// and co_return whether it succeeded. PerformState ticks the task every frame, a
+// suspended task only checks its wake condition until it is resumed
+/*=============================================================================*/
+
+#include <coroutine>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Recycles coroutine frames in a few size classes, frames bigger than the largest class use the heap
+class ActionFramePool final
+{
+public:
+	static ActionFramePool* GetInstance()
+	{
+		if (!instance)
+		{
+			instance = new ActionFramePool();
+		}
+		return instance;
+	}
+	~ActionFramePool();
+
+	void* Allocate(size_t size);
+	void Deallocate(void* pFrame, size_t size);
+
+	size_t GetPooledFrameCount() const { return m_PooledFrameCount; };
+	size_t GetHeapFrameCount() const { return m_HeapFrameCount; };
+
+	static ActionFramePool* instance;
+private:
+	ActionFramePool() = default;
+
+	struct FreeFrame
+	{
+		FreeFrame* pNext;
+	};
+
+	static const size_t SizeClassCount = 4;
+	static const size_t SmallestSizeClass = 256;
+
+	FreeFrame* m_pFreeLists[SizeClassCount]{};
+	size_t m_PooledFrameCount{ 0 }; // Frames that were ever allocated for the pool
+	size_t m_HeapFrameCount{ 0 }; // Frames that were too big for the pool
+
+	static int GetSizeClass(size_t size);
+};
+
+class ActionTask final
+{
+public:
+	// Why a suspended task is waiting
+	enum class WakeCondition
+	{
+		NEXT_FRAME,
+		TIME,
+		PREDICATE
+	};
+
+	struct promise_type
+	{
+		WakeCondition wakeCondition{ WakeCondition::NEXT_FRAME };
+		float wakeTime{ 0.f };
+		// Type erased WaitUntil predicate, the functor lives in the awaiter inside the coroutine frame
+		bool(*pPredicate)(const void*) = nullptr;
+		const void* pPredicateData = nullptr;
+
+		// Accumulated by ActionTask::Tick, used for WaitSeconds
+		float time{ 0.f };
+		bool succeeded{ false };
+
+		ActionTask get_return_object() { return ActionTask{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+		// Runs on the first tick, not when the action creates it
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_value(bool success) { succeeded = success; }
+		void unhandled_exception() { succeeded = false; }
+
+		static void* operator new(size_t size) { return ActionFramePool::GetInstance()->Allocate(size); }
+		static void operator delete(void* pFrame, size_t size) { ActionFramePool::GetInstance()->Deallocate(pFrame, size); }
+	};
+
+	ActionTask() = default;
+	~ActionTask();
+	ActionTask(const ActionTask&) = delete;
+	ActionTask& operator=(const ActionTask&) = delete;
+	ActionTask(ActionTask&& other) noexcept;
+	ActionTask& operator=(ActionTask&& other) noexcept;
+
+	// Advances time and resumes the coroutine if its wake condition is met. Returns true once the coroutine finished
+	bool Tick(float deltaTime);
+
+	bool IsValid() const { return bool(m_Handle); };
+	bool IsFinished() const { return m_Handle && m_Handle.done(); };
+	bool Succeeded() const { return IsFinished() && m_Handle.promise().succeeded; };
+private:
+	explicit ActionTask(std::coroutine_handle<promise_type> handle) : m_Handle(handle) {}
+
+	std::coroutine_handle<promise_type> m_Handle{};
+
+	bool IsAwake() const;
+};
+
+// AWAITABLES
+// -----------
+// Resume on the next tick
+struct NextFrame
+{
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<ActionTask::promise_type> handle) const noexcept
+	{
+		handle.promise().wakeCondition = ActionTask::WakeCondition::NEXT_FRAME;
+	}
+	void await_resume() const noexcept {}
+};
+
+// Resume once the given amount of seconds passed
+struct WaitSeconds
+{
+	float seconds;
+
+	bool await_ready() const noexcept { return seconds <= 0.f; }
+	void await_suspend(std::coroutine_handle<ActionTask::promise_type> handle) const noexcept
+	{
+		ActionTask::promise_type& promise = handle.promise();
+		promise.wakeCondition = ActionTask::WakeCondition::TIME;
+		promise.wakeTime = promise.time + seconds;
+	}
+	void await_resume() const noexcept {}
+};
+
+// Resume on the first tick the predicate returns true, the predicate is checked before suspending too
+template<typename Predicate>
+struct WaitUntilAwaiter
+{
+	Predicate predicate;
+
+	bool await_ready() { return predicate(); }
+	void await_suspend(std::coroutine_handle<ActionTask::promise_type> handle) const noexcept
+	{
+		ActionTask::promise_type& promise = handle.promise();
+		promise.wakeCondition = ActionTask::WakeCondition::PREDICATE;
+		promise.pPredicate = [](const void* pData) { return (*static_cast<const Predicate*>(pData))(); };
+		promise.pPredicateData = &predicate;
+	}
+	void await_resume() const noexcept {}
+};
+
+template<typename Predicate>
+WaitUntilAwaiter<std::decay_t<Predicate>> WaitUntil(Predicate&& predicate)
+{
+	return WaitUntilAwaiter<std::decay_t<Predicate>>{ std::forward<Predicate>(predicate) };
+}
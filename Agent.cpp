@@ -7,17 +7,26 @@
 #include "GOAPPlanner.h"
 #include "DecisionMaking.h"
 #include "Blackboard.h"
+#include "BlackboardKeys.h"
 #include "FSMState.h"
 #include "StatesAndTransitions.h"
 #include "ConfigManager.h"
+#include "WorldStateHistory.h"
+#include "TickScheduler.h"
+#include "AILevelOfDetail.h"
+#include "PerceptionSnapshot.h"
+#include "CachedExamInterface.h"
+#include "InterfaceProfiler.h"
+#include "WorldMemory.h"
+#include "SeekTargetScorer.h"
+#include "LootTourPlanner.h"
 
 Agent::Agent(IExamInterface* pInterface) :
 	m_pInterface(pInterface)
 {
 	DebugOutputManager::GetInstance()->DebugLine("ZombieAI version 1.0\n", DebugOutputManager::DebugType::CONSTRUCTION);
 	Initialize();
-	m_ExploredLocationTimer = m_ExploredLocationRefreshTime;
-	m_MaxInventorySlots = m_pInterface->Inventory_GetCapacity();
+	m_MaxInventorySlots = m_pInterfaceCache->Inventory_GetCapacity();
 }
 
 Agent::~Agent()
@@ -27,6 +36,10 @@ Agent::~Agent()
 	DeleteBehaviors();
 	DeleteBlackboard();
 	DeleteWorldState();
+	DeleteTickScheduler();
+	DeletePerception();
+	DeleteInterfaceCache();
+	DeleteWorldMemory();
 
 	DebugOutputManager::GetInstance()->DebugLine("Deconstructed agent\n\n\n",
 		DebugOutputManager::DebugType::DESTRUCTION);
@@ -36,10 +49,26 @@ Agent::~Agent()
 SteeringPlugin_Output Agent::UpdateSteering(float dt)
 {
 	SteeringPlugin_Output steering{};
-
-	// Get interface information
-	AgentInfo& agentInfo = m_pInterface->Agent_GetInfo();
-	auto vEntitiesInFOV = utils::GetEntitiesInFOV(m_pInterface); //uses m_pInterface->Fov_GetEntityByIndex(...)
+	// Measured for the level of detail
+	auto updateStart = std::chrono::high_resolution_clock::now();
+
+	// Stamp worldstate changes with the current frame
+	if (m_pWorldStateHistory)
+		m_pWorldStateHistory->SetFrame(m_FrameCount);
+	++m_FrameCount;
+	m_pTickScheduler->BeginFrame(dt);
+	m_pInterfaceCache->BeginFrame(dt);
+	InterfaceProfiler::GetInstance()->BeginFrame(m_FrameCount);
+	InterfaceProfileScope agentScope{ "Agent" };
+
+	// Get interface information, the perception is shared with every other consumer this tick
+	AgentInfo agentInfo = m_pInterfaceCache->Agent_GetInfo();
+	{
+		InterfaceProfileScope perceptionScope{ "Perception" };
+		m_pPerception->Update(m_pInterfaceCache, m_FrameCount);
+	}
+	const std::vector<EntityInfo>& vEntitiesInFOV = m_pPerception->GetEntities();
+	m_pWorldMemory->Update(dt, agentInfo.Position);
 	// Set the house the agent is in
 	SetAgentHouseInBlackboard(agentInfo.Position);
 
@@ -68,26 +97,19 @@ SteeringPlugin_Output Agent::UpdateSteering(float dt)
 	// Reset worldstate
 	m_pWorldState->SetState("EnemyInSight", false);
 	// Manage fast scout timer
-	if (m_FastScoutTimer > m_FastScoutTime)
-	{
-		m_FastScoutTimer = 0.f;
+	if (m_pTickScheduler->TryRun(ScheduledTask::FAST_SCOUT))
 		m_pWorldState->SetState("FastScoutAllowed", true);
-	}
-	m_FastScoutTimer += dt;
 
 	// Get most nearby enemy and enemy count
 	float closestDistanceSq{ FLT_MAX };
-	for (auto& enemyInFov : vEntitiesInFOV)
+	for (const EntityInfo& enemyInFov : m_pPerception->GetEnemies())
 	{
-		if (enemyInFov.Type == eEntityType::ENEMY)
+		float distanceToEnemySq = agentInfo.Position.DistanceSquared(enemyInFov.Location);
+		if (distanceToEnemySq < closestDistanceSq)
 		{
-			float distanceToEnemySq = agentInfo.Position.DistanceSquared(enemyInFov.Location);
-			if (distanceToEnemySq < closestDistanceSq)
-			{
-				m_LastSeenClosestEnemy = enemyInFov.Location;
-				m_pBlackboard->ChangeData("LastEnemyPos", &m_LastSeenClosestEnemy);
-				m_pWorldState->SetState("EnemyInSight", true);
-			}
+			m_LastSeenClosestEnemy = enemyInFov.Location;
+			m_pBlackboard->ChangeData(BlackboardKeys::LAST_ENEMY_POS, &m_LastSeenClosestEnemy);
+			m_pWorldState->SetState("EnemyInSight", true);
 		}
 	}
 
@@ -96,12 +118,14 @@ SteeringPlugin_Output Agent::UpdateSteering(float dt)
 	// Update FSM states
 	if (m_pDecisionMaking)
 	{
+		InterfaceProfileScope decisionScope{ "DecisionMaking" };
 		m_pDecisionMaking->Update(m_pInterface, m_pGOAPPlanner, dt);
 	}
 
 	// Steer
 	if (m_pSteeringBehavior)
 	{
+		InterfaceProfileScope steeringScope{ "Steering" };
 		steering = m_pSteeringBehavior->CalculateSteering(m_pInterface, dt, agentInfo, m_pBlackboard);
 	}
 
@@ -113,12 +137,18 @@ SteeringPlugin_Output Agent::UpdateSteering(float dt)
 	m_ScoutedVectors.erase(std::remove_if(m_ScoutedVectors.begin(), m_ScoutedVectors.end(),
 		[](Line& l) { return l.lifeTime <= 0.f; }), m_ScoutedVectors.end());
 
+	// Hand this tick's blackboard values to readers on other threads
+	m_pBlackboard->Publish();
+
+	std::chrono::duration<float, std::milli> updateCost = std::chrono::high_resolution_clock::now() - updateStart;
+	m_pLevelOfDetail->EndFrame(updateCost.count(), dt);
+
 	return steering;
 }
 // Render
 void Agent::Render(IExamInterface* pExamInterface, float dt) const
 {
-	if (ConfigManager::GetInstance()->GetDebugHouseScoutVectors())
+	if (ConfigManager::GetInstance()->GetDebugHouseScoutVectors() && m_pLevelOfDetail->AllowDebugDraw())
 	{
 		for (const Line& l : m_ScoutedVectors)
 		{
@@ -162,8 +192,8 @@ bool Agent::GrabItem(EntityInfo& i, IExamInterface* pInterface)
 {
 	// Get info
 	ItemInfo itemInfo;
-	pInterface->Item_GetInfo(i, itemInfo);
-	AgentInfo agentInfo = pInterface->Agent_GetInfo();
+	m_pInterfaceCache->Item_GetInfo(i, itemInfo);
+	const AgentInfo& agentInfo = m_pInterfaceCache->Agent_GetInfo();
 
 	// Check if the item is within grabrange
 	float distanceSquared = agentInfo.Position.DistanceSquared(itemInfo.Location);
@@ -172,7 +202,7 @@ bool Agent::GrabItem(EntityInfo& i, IExamInterface* pInterface)
 		// Don't pick up garbage
 		if (itemInfo.Type == eItemType::GARBAGE)
 		{
-			bool destroyed = pInterface->Item_Destroy(i);
+			bool destroyed = m_pInterfaceCache->Item_Destroy(i);
 			return destroyed;
 		}
 
@@ -191,13 +221,13 @@ bool Agent::ConsumeItem(const eItemType& itemType)
 	while (index < m_MaxInventorySlots)
 	{
 		ItemInfo inventoryItem;
-		bool itemFound = m_pInterface->Inventory_GetItem(index, inventoryItem);
+		bool itemFound = m_pInterfaceCache->Inventory_GetItem(index, inventoryItem);
 		if (itemFound)
 		{
 			if (inventoryItem.Type == itemType)
 			{
-				success = m_pInterface->Inventory_UseItem(index);
-				m_pInterface->Inventory_RemoveItem(index);
+				success = m_pInterfaceCache->Inventory_UseItem(index);
+				m_pInterfaceCache->Inventory_RemoveItem(index);
 				break;
 			}
 		}
@@ -214,7 +244,7 @@ bool Agent::Shoot()
 	while (index < m_MaxInventorySlots)
 	{
 		ItemInfo itemInfo;
-		m_pInterface->Inventory_GetItem(index, itemInfo);
+		m_pInterfaceCache->Inventory_GetItem(index, itemInfo);
 
 		// Item is a gun
 		if (itemInfo.Type == eItemType::PISTOL)
@@ -226,11 +256,11 @@ bool Agent::Shoot()
 				// Make sure we can only shoot once
 				shotGun = true;
 				// Shoot
-				m_pInterface->Inventory_UseItem(index);
+				m_pInterfaceCache->Inventory_UseItem(index);
 				// Remove then gun from inventory if it has no ammo left
-				if (m_pInterface->Weapon_GetAmmo(itemInfo) < 1)
+				if (m_pInterfaceCache->Weapon_GetAmmo(itemInfo) < 1)
 				{
-					m_pInterface->Inventory_RemoveItem(index);
+					m_pInterfaceCache->Inventory_RemoveItem(index);
 					// We have one less gun
 					--gunsFound;
 				}
@@ -257,7 +287,7 @@ bool Agent::AddInventoryItem(const EntityInfo& entity)
 
 	// Get item info
 	ItemInfo lootedItemInfo;
-	m_pInterface->Item_GetInfo(entity, lootedItemInfo);
+	m_pInterfaceCache->Item_GetInfo(entity, lootedItemInfo);
 	eItemType lootedItemType{ lootedItemInfo.Type };
 
 	std::vector<int> medkitsFoundIndices{  };
@@ -269,17 +299,17 @@ bool Agent::AddInventoryItem(const EntityInfo& entity)
 	while (index < m_MaxInventorySlots)
 	{
 		ItemInfo itemInCurrentSlot{};
-		bool itemFound = m_pInterface->Inventory_GetItem(index, itemInCurrentSlot);
+		bool itemFound = m_pInterfaceCache->Inventory_GetItem(index, itemInCurrentSlot);
 
 		// Found an empty inventory slot
 		if (!itemFound)
 		{
 			// Grab the item from the ground
-			bool grabSuccess = m_pInterface->Item_Grab(entity, lootedItemInfo);
+			bool grabSuccess = m_pInterfaceCache->Item_Grab(entity, lootedItemInfo);
 			if (!grabSuccess) return false;
 
 			// Add the grabbed item to the inventory
-			success = m_pInterface->Inventory_AddItem(index, lootedItemInfo);
+			success = m_pInterfaceCache->Inventory_AddItem(index, lootedItemInfo);
 			if (success)
 			{
 				ProcessItemWorldState(lootedItemInfo.Type);
@@ -315,10 +345,10 @@ bool Agent::AddInventoryItem(const EntityInfo& entity)
 					if (RemoveInventoryItem(index, itemInCurrentSlot))
 					{
 						// Grab the item from the ground
-						bool grabSuccess = m_pInterface->Item_Grab(entity, lootedItemInfo);
+						bool grabSuccess = m_pInterfaceCache->Item_Grab(entity, lootedItemInfo);
 						if (!grabSuccess) return false;
 						// Add the grabbed item to the inventory
-						success = m_pInterface->Inventory_AddItem(index, lootedItemInfo);
+						success = m_pInterfaceCache->Inventory_AddItem(index, lootedItemInfo);
 						if (success)
 						{
 							ProcessItemWorldState(lootedItemInfo.Type);
@@ -393,10 +423,10 @@ bool Agent::AddInventoryItem(const EntityInfo& entity)
 			if (RemoveInventoryItem(random))
 			{
 				// Grab the item from the ground
-				bool grabSuccess = m_pInterface->Item_Grab(entity, lootedItemInfo);
+				bool grabSuccess = m_pInterfaceCache->Item_Grab(entity, lootedItemInfo);
 				if (!grabSuccess) return false;
 				// Add the grabbed item to the inventory
-				success = m_pInterface->Inventory_AddItem(random, lootedItemInfo);
+				success = m_pInterfaceCache->Inventory_AddItem(random, lootedItemInfo);
 				// Process the world states
 				if (success)
 					ProcessItemWorldState(lootedItemInfo.Type);
@@ -413,7 +443,7 @@ bool Agent::AddInventoryItem(const EntityInfo& entity)
 		else
 		{
 			// No place for item, destroy it
-			success = m_pInterface->Item_Destroy(entity);
+			success = m_pInterfaceCache->Item_Destroy(entity);
 		}
 	}
 
@@ -422,7 +452,7 @@ bool Agent::AddInventoryItem(const EntityInfo& entity)
 bool Agent::RemoveInventoryItem(int itemIndex)
 {
 	ItemInfo itemInfo;
-	m_pInterface->Inventory_GetItem(itemIndex, itemInfo);
+	m_pInterfaceCache->Inventory_GetItem(itemIndex, itemInfo);
 	return RemoveInventoryItem(itemIndex, itemInfo);
 }
 bool Agent::RemoveInventoryItem(int itemIndex, const ItemInfo& itemInfo)
@@ -431,13 +461,13 @@ bool Agent::RemoveInventoryItem(int itemIndex, const ItemInfo& itemInfo)
 	// Removing food or medkits would be a waste without using them up
 	if (itemInfo.Type == eItemType::FOOD || itemInfo.Type == eItemType::MEDKIT)
 	{
-		m_pInterface->Inventory_UseItem(itemIndex);
-		removed = m_pInterface->Inventory_RemoveItem(itemIndex);
+		m_pInterfaceCache->Inventory_UseItem(itemIndex);
+		removed = m_pInterfaceCache->Inventory_RemoveItem(itemIndex);
 		ProcessItemWorldState(itemInfo.Type);
 	}
 	else
 	{
-		removed = m_pInterface->Inventory_RemoveItem(itemIndex);
+		removed = m_pInterfaceCache->Inventory_RemoveItem(itemIndex);
 	}
 
 	return removed;
@@ -449,13 +479,13 @@ int Agent::GetItemStackSize(ItemInfo& itemInfo) const
 	switch (itemInfo.Type)
 	{
 	case eItemType::FOOD:
-		stackSize = m_pInterface->Food_GetEnergy(itemInfo);
+		stackSize = m_pInterfaceCache->Food_GetEnergy(itemInfo);
 		break;
 	case eItemType::MEDKIT:
-		stackSize = m_pInterface->Medkit_GetHealth(itemInfo);
+		stackSize = m_pInterfaceCache->Medkit_GetHealth(itemInfo);
 		break;
 	case eItemType::PISTOL:
-		stackSize = m_pInterface->Weapon_GetAmmo(itemInfo);
+		stackSize = m_pInterfaceCache->Weapon_GetAmmo(itemInfo);
 		break;
 	}
 
@@ -478,27 +508,21 @@ void Agent::ProcessItemWorldState(const eItemType& itemType)
 }
 void Agent::SetAgentHouseInBlackboard(const Elite::Vector2& agentPos)
 {
-	ExploredHouse* pHouse = nullptr;
-	for (ExploredHouse& h : m_Houses)
-	{
-		float housePadding{ 1.f };
-		float halfWidth = h.houseInfo.Size.x / 2.f;
-		float halfHeight = h.houseInfo.Size.y / 2.f;
-		// Check if agent location is in the house
-		if ((agentPos.x + housePadding < h.houseInfo.Center.x + halfWidth) && (agentPos.x - housePadding > h.houseInfo.Center.x - halfWidth) &&
-			(agentPos.y + housePadding < h.houseInfo.Center.y + halfHeight) && (agentPos.y - housePadding > h.houseInfo.Center.y - halfHeight))
-		{
-			pHouse = &h;
-			break;
-		}
-	}
-
-	m_pBlackboard->ChangeData("AgentHouse", pHouse);
+	float housePadding{ 1.f };
+	// The house from last frame is tested first, the agent rarely leaves it
+	int agentHouse{ -1 };
+	m_pBlackboard->GetData(BlackboardKeys::AGENT_HOUSE, agentHouse);
+	m_pBlackboard->ChangeData(BlackboardKeys::AGENT_HOUSE, m_pWorldMemory->FindHouseContaining(agentPos, housePadding, agentHouse));
 }
 
 // Initialization
 void Agent::Initialize()
 {
+	// Scheduler, level of detail, perception and interface cache, subsystems find them through the blackboard
+	InitializeTickScheduler();
+	InitializePerception();
+	InitializeInterfaceCache();
+	InitializeWorldMemory();
 	// InitializeWorldState
 	InitializeWorldState();
 	// Blackboard
@@ -516,28 +540,78 @@ void Agent::Initialize()
 void Agent::InitializeWorldState()
 {
 	m_pWorldState = new WorldState();
+	if (ConfigManager::GetInstance()->GetRecordWorldStateHistory())
+	{
+		m_pWorldStateHistory = new WorldStateHistory(ConfigManager::GetInstance()->GetWorldStateHistoryCapacity());
+		m_pWorldState->SetHistory(m_pWorldStateHistory);
+	}
 	m_pWorldState->AddState("EnemyInSight", false);
 	m_pWorldState->AddState("HasFood", false);
 	m_pWorldState->AddState("HasMedkit", false);
 	m_pWorldState->AddState("HasWeapon", false);
 }
+void Agent::InitializeTickScheduler()
+{
+	ConfigManager* pConfig = ConfigManager::GetInstance();
+	m_pTickScheduler = new TickScheduler();
+
+	// Expensive tasks get different phases so they don't all become due on the first frames
+	m_pTickScheduler->RegisterTask(ScheduledTask::PLANNER, pConfig->GetPlannerInterval(), 0.f, true);
+	m_pTickScheduler->RegisterTask(ScheduledTask::PATH_REFRESH, pConfig->GetPathRefreshInterval(), 0.f, true);
+	m_pTickScheduler->RegisterTask(ScheduledTask::NAVMESH_REFRESH, pConfig->GetNavMeshRefreshInterval(), pConfig->GetNavMeshRefreshInterval() * .5f, true);
+	m_pTickScheduler->RegisterTask(ScheduledTask::SEEK_LOCATION, pConfig->GetSeekLocationInterval(), pConfig->GetSeekLocationInterval() * .5f, true);
+	m_pTickScheduler->RegisterTask(ScheduledTask::FAST_SCOUT, pConfig->GetFastScoutInterval(), 0.f, false);
+
+	m_pLevelOfDetail = new AILevelOfDetail(m_pTickScheduler);
+}
+void Agent::InitializePerception()
+{
+	m_pPerception = new PerceptionSnapshot();
+}
+void Agent::InitializeWorldMemory()
+{
+	// Positions are quantized over the world bounds
+	m_pWorldMemory = new WorldMemory(ConfigManager::GetInstance()->GetWorldMemoryCellSize(), m_pInterfaceCache->World_GetInfo());
+	m_pSeekTargetScorer = new SeekTargetScorer();
+	m_pLootTourPlanner = new LootTourPlanner();
+}
+void Agent::InitializeInterfaceCache()
+{
+	m_pInterfaceCache = new CachedExamInterface(m_pInterface);
+
+	ConfigManager* pConfig = ConfigManager::GetInstance();
+	if (pConfig->GetProfileInterface())
+	{
+		if (!InterfaceProfiler::GetInstance()->Open(pConfig->GetInterfaceProfileFile(), pConfig->GetInterfaceHistogramFile()))
+			DebugOutputManager::GetInstance()->DebugLine("Failed to open " + pConfig->GetInterfaceProfileFile() + "\n",
+				DebugOutputManager::DebugType::PROBLEM);
+	}
+}
 void Agent::InitializeBlackboard()
 {
-	m_pBlackboard = new Blackboard();
-	m_pBlackboard->AddData("Agent", this);
-	m_pBlackboard->AddData("LastEnemyPos", &m_LastSeenClosestEnemy);
-	m_pBlackboard->AddData("EnemyCount", &m_EnemyCount);
-	m_pBlackboard->AddData("WorldState", m_pWorldState);
-	m_pBlackboard->AddData("PriorityAction", false);
-	m_pBlackboard->AddData("HouseLocations", &m_Houses);
-	m_pBlackboard->AddData("ItemLocations", &m_Items);
-	m_pBlackboard->AddData("AgentHouse", m_AgentHouse);
-	m_pBlackboard->AddData("AgentInPurgeZone", false);
-	m_pBlackboard->AddData("HouseCornerLocations", &m_HouseCornerLocations);
+	m_pBlackboard = new Blackboard(ConfigManager::GetInstance()->GetDoubleBufferedBlackboard());
+	m_pBlackboard->AddData(BlackboardKeys::AGENT, this);
+	m_pBlackboard->AddData(BlackboardKeys::LAST_ENEMY_POS, &m_LastSeenClosestEnemy);
+	m_pBlackboard->AddData(BlackboardKeys::ENEMY_COUNT, &m_EnemyCount);
+	m_pBlackboard->AddData(BlackboardKeys::WORLD_STATE, m_pWorldState);
+	m_pBlackboard->AddData(BlackboardKeys::PRIORITY_ACTION, false);
+	m_pBlackboard->AddData(BlackboardKeys::WORLD_MEMORY, m_pWorldMemory);
+	m_pBlackboard->AddData(BlackboardKeys::SEEK_TARGETS, m_pSeekTargetScorer);
+	m_pBlackboard->AddData(BlackboardKeys::LOOT_TOUR, m_pLootTourPlanner);
+	m_pBlackboard->AddData(BlackboardKeys::AGENT_HOUSE, -1);
+	m_pBlackboard->AddData(BlackboardKeys::AGENT_IN_PURGE_ZONE, false);
 
 	// Debug
-	m_pBlackboard->AddData("ScoutedVectors", &m_ScoutedVectors);
-	m_pBlackboard->AddData("DebugNavMeshExploration", &m_DebugNavMeshExploration);
+	m_pBlackboard->AddData(BlackboardKeys::SCOUTED_VECTORS, &m_ScoutedVectors);
+	m_pBlackboard->AddData(BlackboardKeys::DEBUG_NAVMESH_EXPLORATION, &m_DebugNavMeshExploration);
+
+	// Scheduling
+	m_pBlackboard->AddData(BlackboardKeys::TICK_SCHEDULER, m_pTickScheduler);
+	m_pBlackboard->AddData(BlackboardKeys::LEVEL_OF_DETAIL, m_pLevelOfDetail);
+
+	// Perception
+	m_pBlackboard->AddData(BlackboardKeys::PERCEPTION, static_cast<const PerceptionSnapshot*>(m_pPerception));
+	m_pBlackboard->AddData(BlackboardKeys::INTERFACE_CACHE, m_pInterfaceCache);
 }
 void Agent::InitializeBehaviors()
 {
@@ -570,6 +644,18 @@ void Agent::InitializeGOAP()
 }
 void Agent::InitializeFSM()
 {
+	m_pGOAPPlanner->SetEventDriven(ConfigManager::GetInstance()->GetEventDrivenFSM());
+
+	// Compile time FSM, owns its states and transitions
+	if (ConfigManager::GetInstance()->GetStaticFSM())
+	{
+		AgentStaticFSM* pStaticFiniteStateMachine = new AgentStaticFSM(nullptr, m_pGOAPPlanner, m_pBlackboard);
+		pStaticFiniteStateMachine->SetEventDriven(ConfigManager::GetInstance()->GetEventDrivenFSM());
+		m_pStaticFiniteStateMachine = pStaticFiniteStateMachine;
+		m_pDecisionMaking = m_pStaticFiniteStateMachine;
+		return;
+	}
+
 	IdleState* pIdleState = new IdleState();
 	GoToState* pGoToState = new GoToState();
 	PerformState* pPerformState = new PerformState();
@@ -585,6 +671,7 @@ void Agent::InitializeFSM()
 
 	// FSM
 	m_pFiniteStateMachine = new FiniteStateMachine(pIdleState, nullptr, m_pGOAPPlanner, m_pBlackboard);
+	m_pFiniteStateMachine->SetEventDriven(ConfigManager::GetInstance()->GetEventDrivenFSM());
 	// The action requires movement before performing, go to GoTo state
 	m_pFiniteStateMachine->AddTransition(pIdleState, pGoToState, pGoToTransition);
 	// The action doesn't require any movement, go to perform state
@@ -619,6 +706,9 @@ void Agent::DeleteFSM()
 
 	delete m_pFiniteStateMachine;
 	m_pFiniteStateMachine = nullptr;
+
+	delete m_pStaticFiniteStateMachine;
+	m_pStaticFiniteStateMachine = nullptr;
 }
 void Agent::DeleteGOAP()
 {
@@ -649,8 +739,48 @@ void Agent::DeleteBlackboard()
 	delete m_pBlackboard;
 	m_pBlackboard = nullptr;
 }
+void Agent::DeleteInterfaceCache()
+{
+	InterfaceProfiler::GetInstance()->Close();
+	delete m_pInterfaceCache;
+	m_pInterfaceCache = nullptr;
+}
+void Agent::DeleteWorldMemory()
+{
+	delete m_pLootTourPlanner;
+	m_pLootTourPlanner = nullptr;
+	delete m_pSeekTargetScorer;
+	m_pSeekTargetScorer = nullptr;
+	delete m_pWorldMemory;
+	m_pWorldMemory = nullptr;
+}
+void Agent::DeletePerception()
+{
+	delete m_pPerception;
+	m_pPerception = nullptr;
+}
+void Agent::DeleteTickScheduler()
+{
+	delete m_pLevelOfDetail;
+	m_pLevelOfDetail = nullptr;
+
+	delete m_pTickScheduler;
+	m_pTickScheduler = nullptr;
+}
 void Agent::DeleteWorldState()
 {
+	if (m_pWorldStateHistory)
+	{
+		const std::string& historyFile = ConfigManager::GetInstance()->GetWorldStateHistoryFile();
+		if (!m_pWorldStateHistory->DumpToFile(historyFile, m_pWorldState->GetStateNames(), m_pWorldState->GetValues()))
+		{
+			DebugOutputManager::GetInstance()->DebugLine("Failed to write worldstate history to " + historyFile + "\n",
+				DebugOutputManager::DebugType::PROBLEM);
+		}
+		delete m_pWorldStateHistory;
+		m_pWorldStateHistory = nullptr;
+	}
+
 	delete m_pWorldState;
 	m_pWorldState = nullptr;
 }
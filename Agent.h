@@ -16,6 +16,14 @@ class FSMTransition;
 class FiniteStateMachine;
 // Information
 class Blackboard;
+class WorldStateHistory;
+class TickScheduler;
+class AILevelOfDetail;
+class PerceptionSnapshot;
+class CachedExamInterface;
+class WorldMemory;
+class SeekTargetScorer;
+class LootTourPlanner;
 class Agent
 {
 public:
@@ -41,10 +49,13 @@ public:
 	bool WasBitten() const;
 private:
 	IExamInterface* m_pInterface = nullptr;
+	// Answers the repeated interface queries, inventory changes have to go through it as well
+	CachedExamInterface* m_pInterfaceCache = nullptr;
 	// Decision making 
 	std::vector<FSMState*> m_pStates{};
 	std::vector<FSMTransition*> m_pTransitions{};
-	FiniteStateMachine* m_pFiniteStateMachine;
+	FiniteStateMachine* m_pFiniteStateMachine = nullptr;
+	DecisionMaking* m_pStaticFiniteStateMachine = nullptr; // AgentStaticFSM, used instead of the runtime FSM when enabled in the config
 
 	// Planner
 	GOAPPlanner* m_pGOAPPlanner = nullptr;
@@ -60,20 +71,27 @@ private:
 	// Data
 	Blackboard* m_pBlackboard = nullptr;
 	WorldState* m_pWorldState = nullptr;
+	WorldStateHistory* m_pWorldStateHistory = nullptr;
 	int m_MaxInventorySlots{-1};
+	uint32_t m_FrameCount{ 0 };
+
+	// Periodic work of all subsystems, rates come from the ConfigManager
+	TickScheduler* m_pTickScheduler = nullptr;
+	// Lowers the detail of the AI when the update goes over its frame budget
+	AILevelOfDetail* m_pLevelOfDetail = nullptr;
+
+	// Everything in the FOV this frame, gathered once per tick
+	PerceptionSnapshot* m_pPerception = nullptr;
 
 	// Exploration
-	std::vector<ExploredHouse> m_Houses{};
-	std::vector<Elite::Vector2> m_HouseCornerLocations{};
-	ExploredHouse* m_AgentHouse = nullptr;
-	std::list<EntityInfo> m_Items{};
+	// Remembered items, houses, corners and purge zones
+	WorldMemory* m_pWorldMemory = nullptr;
+	// Seek targets scored from the world memory, shared by the search actions
+	SeekTargetScorer* m_pSeekTargetScorer = nullptr;
+	// Route through the items around the agent, followed until the item set changes
+	LootTourPlanner* m_pLootTourPlanner = nullptr;
 	Elite::Vector2 m_GoalPosition{ 0.f,0.f };
 	Elite::Vector2 m_DistantGoalPosition{ 0.f,0.f };
-	float m_ExploredLocationRefreshTime = .1f;
-	float m_ExploredLocationTimer = 0.f;
-	// Fast scout goap action worldstate timer
-	float m_FastScoutTimer = 0.f; // Current timer towards doing a fast scout
-	float m_FastScoutTime = 3.f; // Required time for doing a fastscout
 
 	// Enemy tracking
 	Elite::Vector2 m_LastSeenClosestEnemy{};
@@ -104,6 +122,10 @@ private:
 	void SetAgentHouseInBlackboard(const Elite::Vector2& agentPos);
 
 	void Initialize();
+	void InitializeTickScheduler();
+	void InitializePerception();
+	void InitializeWorldMemory();
+	void InitializeInterfaceCache();
 	void InitializeBlackboard();
 	void InitializeWorldState();
 	void InitializeBehaviors();
@@ -115,5 +137,9 @@ private:
 	void DeleteBehaviors();
 	void DeleteWorldState();
 	void DeleteBlackboard();
+	void DeleteTickScheduler();
+	void DeletePerception();
+	void DeleteWorldMemory();
+	void DeleteInterfaceCache();
 };
 
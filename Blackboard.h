@@ -7,15 +7,43 @@
 /*=============================================================================*/
 #pragma once
 #include <unordered_map>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <cassert>
+#include <atomic>
+#include <typeinfo>
+#include <type_traits>
 
 //-----------------------------------------------------------------
 // BLACKBOARD TYPES (BASE)
 //-----------------------------------------------------------------
+//Unique address per type, lets keyed reads verify their type in debug without RTTI
+template<typename T>
+const void* GetBlackboardTypeTag()
+{
+	static const char tag{};
+	return &tag;
+}
+
 class IBlackBoardField
 {
 public:
-	IBlackBoardField() = default;
+	explicit IBlackBoardField(const void* typeTag) : m_TypeTag(typeTag)
+	{}
 	virtual ~IBlackBoardField() = default;
+	const void* GetTypeTag() const { return m_TypeTag; }
+	uint32_t GetVersion() const { return m_Version; }
+	//Copies the staged value into one of the published buffers
+	virtual void Publish(int bufferIndex) = 0;
+
+protected:
+	void BumpVersion() { ++m_Version; }
+
+private:
+	const void* m_TypeTag;
+	uint32_t m_Version = 0;
 };
 
 //BlackboardField does not take ownership of pointers whatsoever!
@@ -23,53 +51,158 @@ template<typename T>
 class BlackboardField : public IBlackBoardField
 {
 public:
-	explicit BlackboardField(T data) : m_Data(data)
+	explicit BlackboardField(T data) : IBlackBoardField(GetBlackboardTypeTag<T>()), m_Data(data), m_Published{ data, data }
 	{}
 	T GetData() { return m_Data; };
-	void SetData(T data) { m_Data = data; }
+	T GetPublishedData(int bufferIndex) const { return m_Published[bufferIndex]; };
+	void Publish(int bufferIndex) override { m_Published[bufferIndex] = m_Data; }
+	//Only bumps the version when the value actually changes
+	void SetData(T data)
+	{
+		if (m_Data == data)
+			return;
+		m_Data = data;
+		BumpVersion();
+	}
 
 private:
 	T m_Data;
+	T m_Published[2];
+};
+
+//Typed handle to a blackboard entry, declared once (see BlackboardKeys.h)
+template<typename T>
+struct BlackboardKey
+{
+	size_t index;
+	const char* name;
+};
+
+class Blackboard;
+
+//Remembers the last version of an entry a consumer has seen
+template<typename T>
+class BlackboardSubscription
+{
+public:
+	explicit BlackboardSubscription(BlackboardKey<T> key, uint32_t seenVersion = InvalidVersion) :
+		m_Key(key), m_SeenVersion(seenVersion)
+	{}
+
+	//Returns true once for every change since the previous call
+	bool ConsumeChange(const Blackboard* pBlackboard);
+	//Makes the next ConsumeChange report a change
+	void Reset() { m_SeenVersion = InvalidVersion; }
+	const BlackboardKey<T>& GetKey() const { return m_Key; }
+
+private:
+	static const uint32_t InvalidVersion = UINT32_MAX;
+	BlackboardKey<T> m_Key;
+	uint32_t m_SeenVersion;
 };
 
 //-----------------------------------------------------------------
 // BLACKBOARD (BASE)
 //-----------------------------------------------------------------
+//Keyed entries are stored at their key index, entries added by name only are appended after them.
+//Register keyed data before adding data by name only.
+//
+//Double buffered mode: the owning thread writes and reads the staged values as usual, Publish() copies
+//them into the back buffer and swaps it to the front. Other threads only read through ReadPublished,
+//which never takes a lock and retries when a publish overwrote the buffer it was reading.
+//All entries have to be added before other threads start reading.
 class Blackboard final
 {
 public:
+	explicit Blackboard(bool doubleBuffered = false) : m_DoubleBuffered(doubleBuffered)
+	{}
+
+	//Read-only view on one published buffer, only valid inside ReadPublished
+	class PublishedView final
+	{
+	public:
+		template<typename T> bool GetData(const BlackboardKey<T>& key, T& data) const
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Concurrently read blackboard data has to be trivially copyable");
+			BlackboardField<T>* p = m_pBlackboard->GetField(key);
+			if (!p)
+				return false;
+			data = p->GetPublishedData(m_BufferIndex);
+			return true;
+		}
+
+	private:
+		friend class Blackboard;
+		PublishedView(const Blackboard* pBlackboard, int bufferIndex) : m_pBlackboard(pBlackboard), m_BufferIndex(bufferIndex)
+		{}
+
+		const Blackboard* m_pBlackboard;
+		int m_BufferIndex;
+	};
+
 	~Blackboard()
 	{
-		for (auto el : m_BlackboardData)
+		for (IBlackBoardField* pField : m_BlackboardData)
 		{
-			if (el.second)
+			if (pField)
 			{
-				delete (el.second);
+				delete pField;
 			}
 		}
 		m_BlackboardData.clear();
+		m_Indices.clear();
+	}
+
+	//Add data to the blackboard under a typed key
+	template<typename T> bool AddData(const BlackboardKey<T>& key, T data)
+	{
+		bool slotTaken = key.index < m_BlackboardData.size() && m_BlackboardData[key.index];
+		if (!slotTaken && m_Indices.find(key.name) == m_Indices.end())
+		{
+			if (key.index >= m_BlackboardData.size())
+				m_BlackboardData.resize(key.index + 1, nullptr);
+			m_BlackboardData[key.index] = new BlackboardField<T>(data);
+			m_Indices[key.name] = key.index;
+			return true;
+		}
+		printf("WARNING: Data '%s' of type '%s' already in Blackboard \n", key.name, typeid(T).name());
+		return false;
 	}
 
 	//Add data to the blackboard
 	template<typename T> bool AddData(const std::string& name, T data)
 	{
-		auto it = m_BlackboardData.find(name);
-		if (it == m_BlackboardData.end())
+		auto it = m_Indices.find(name);
+		if (it == m_Indices.end())
 		{
-			m_BlackboardData[name] = new BlackboardField<T>(data);
+			m_Indices[name] = m_BlackboardData.size();
+			m_BlackboardData.push_back(new BlackboardField<T>(data));
 			return true;
 		}
 		printf("WARNING: Data '%s' of type '%s' already in Blackboard \n", name.c_str(), typeid(T).name());
 		return false;
 	}
 
+	//Change the data of the blackboard through a typed key
+	template<typename T> bool ChangeData(const BlackboardKey<T>& key, T data)
+	{
+		BlackboardField<T>* p = GetField(key);
+		if (p)
+		{
+			p->SetData(data);
+			return true;
+		}
+		printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", key.name, typeid(T).name());
+		return false;
+	}
+
 	//Change the data of the blackboard
 	template<typename T> bool ChangeData(const std::string& name, T data)
 	{
-		auto it = m_BlackboardData.find(name);
-		if (it != m_BlackboardData.end())
+		auto it = m_Indices.find(name);
+		if (it != m_Indices.end())
 		{
-			BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(m_BlackboardData[name]);
+			BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(m_BlackboardData[it->second]);
 			if (p)
 			{
 				p->SetData(data);
@@ -80,19 +213,125 @@ public:
 		return false;
 	}
 
-	//Get the data from the blackboard
-	template<typename T> bool GetData(const std::string& name, T& data)
+	//Get the data from the blackboard through a typed key, a direct indexed load
+	template<typename T> bool GetData(const BlackboardKey<T>& key, T& data) const
 	{
-		BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(m_BlackboardData[name]);
-		if (p != nullptr)
+		BlackboardField<T>* p = GetField(key);
+		if (p)
 		{
 			data = p->GetData();
 			return true;
 		}
+		printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", key.name, typeid(T).name());
+		return false;
+	}
+
+	//Get the data from the blackboard, doesn't insert anything when the name is unknown
+	template<typename T> bool GetData(const std::string& name, T& data) const
+	{
+		auto it = m_Indices.find(name);
+		if (it != m_Indices.end())
+		{
+			BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(m_BlackboardData[it->second]);
+			if (p != nullptr)
+			{
+				data = p->GetData();
+				return true;
+			}
+		}
 		printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
 		return false;
 	}
 
+	//Version of an entry, bumped every time ChangeData changes its value
+	template<typename T> uint32_t GetVersion(const BlackboardKey<T>& key) const
+	{
+		BlackboardField<T>* p = GetField(key);
+		return p ? p->GetVersion() : 0;
+	}
+
+	template<typename T> bool HasChangedSince(const BlackboardKey<T>& key, uint32_t version) const
+	{
+		return GetVersion(key) != version;
+	}
+
+	//Register interest in an entry, the subscription starts at the current version
+	template<typename T> BlackboardSubscription<T> Subscribe(const BlackboardKey<T>& key) const
+	{
+		return BlackboardSubscription<T>(key, GetVersion(key));
+	}
+
+	bool IsDoubleBuffered() const { return m_DoubleBuffered; }
+
+	//Makes the staged values visible to concurrent readers, owning thread only
+	void Publish()
+	{
+		if (!m_DoubleBuffered)
+			return;
+
+		uint32_t sequence = m_PublishSequence.load(std::memory_order_relaxed);
+		int backBuffer = static_cast<int>(((sequence >> 1) + 1) & 1);
+
+		//Odd while writing, readers of the front buffer are not affected
+		m_PublishSequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		for (IBlackBoardField* pField : m_BlackboardData)
+		{
+			if (pField)
+				pField->Publish(backBuffer);
+		}
+		//Swap the back buffer to the front
+		m_PublishSequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	//Reads a consistent snapshot of the last published values from any thread without locking.
+	//readFunc(const PublishedView&) can be called more than once and should only overwrite its outputs.
+	template<typename Func> void ReadPublished(Func readFunc) const
+	{
+		for (;;)
+		{
+			uint32_t sequenceBefore = m_PublishSequence.load(std::memory_order_acquire);
+			readFunc(PublishedView{ this, static_cast<int>((sequenceBefore >> 1) & 1) });
+			std::atomic_thread_fence(std::memory_order_acquire);
+			uint32_t sequenceAfter = m_PublishSequence.load(std::memory_order_relaxed);
+
+			//The buffer we read only gets written again by the publish after the next swap
+			if (sequenceAfter - (sequenceBefore & ~1u) <= 2)
+				return;
+		}
+	}
+
+	template<typename T> bool ReadPublished(const BlackboardKey<T>& key, T& data) const
+	{
+		bool found{ false };
+		ReadPublished([&key, &data, &found](const PublishedView& view) { found = view.GetData(key, data); });
+		return found;
+	}
+
 private:
-	std::unordered_map<std::string, IBlackBoardField*> m_BlackboardData;
-};
\ No newline at end of file
+	std::vector<IBlackBoardField*> m_BlackboardData;
+	std::unordered_map<std::string, size_t> m_Indices;
+
+	bool m_DoubleBuffered;
+	std::atomic<uint32_t> m_PublishSequence{ 0 };
+
+	template<typename T> BlackboardField<T>* GetField(const BlackboardKey<T>& key) const
+	{
+		if (key.index >= m_BlackboardData.size() || !m_BlackboardData[key.index])
+			return nullptr;
+
+		assert(m_BlackboardData[key.index]->GetTypeTag() == GetBlackboardTypeTag<T>());
+		return static_cast<BlackboardField<T>*>(m_BlackboardData[key.index]);
+	}
+};
+
+template<typename T>
+bool BlackboardSubscription<T>::ConsumeChange(const Blackboard* pBlackboard)
+{
+	uint32_t version = pBlackboard->GetVersion(m_Key);
+	if (version == m_SeenVersion)
+		return false;
+
+	m_SeenVersion = version;
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+#include <list>
+#include "Blackboard.h"
+#include "structs.h"
+
+class Agent;
+class WorldState;
+class TickScheduler;
+class AILevelOfDetail;
+class PerceptionSnapshot;
+class CachedExamInterface;
+class WorldMemory;
+class SeekTargetScorer;
+class LootTourPlanner;
+
+// Every entry the agent puts on its blackboard, resolved at compile time
+namespace BlackboardKeys
+{
+	constexpr BlackboardKey<Agent*> AGENT{ 0, "Agent" };
+	constexpr BlackboardKey<Elite::Vector2*> LAST_ENEMY_POS{ 1, "LastEnemyPos" };
+	constexpr BlackboardKey<int*> ENEMY_COUNT{ 2, "EnemyCount" };
+	constexpr BlackboardKey<WorldState*> WORLD_STATE{ 3, "WorldState" };
+	constexpr BlackboardKey<bool> PRIORITY_ACTION{ 4, "PriorityAction" };
+	constexpr BlackboardKey<WorldMemory*> WORLD_MEMORY{ 5, "WorldMemory" };
+	constexpr BlackboardKey<SeekTargetScorer*> SEEK_TARGETS{ 6, "SeekTargets" };
+	// Index into the houses of the WorldMemory, -1 when the agent isn't in a house
+	constexpr BlackboardKey<int> AGENT_HOUSE{ 7, "AgentHouse" };
+	constexpr BlackboardKey<bool> AGENT_IN_PURGE_ZONE{ 8, "AgentInPurgeZone" };
+	constexpr BlackboardKey<LootTourPlanner*> LOOT_TOUR{ 9, "LootTour" };
+
+	// Debug
+	constexpr BlackboardKey<std::vector<Line>*> SCOUTED_VECTORS{ 10, "ScoutedVectors" };
+	constexpr BlackboardKey<bool*> DEBUG_NAVMESH_EXPLORATION{ 11, "DebugNavMeshExploration" };
+
+	// Scheduling
+	constexpr BlackboardKey<TickScheduler*> TICK_SCHEDULER{ 12, "TickScheduler" };
+	constexpr BlackboardKey<AILevelOfDetail*> LEVEL_OF_DETAIL{ 13, "LevelOfDetail" };
+
+	// Perception, refreshed at the start of every tick
+	constexpr BlackboardKey<const PerceptionSnapshot*> PERCEPTION{ 14, "Perception" };
+	constexpr BlackboardKey<CachedExamInterface*> INTERFACE_CACHE{ 15, "InterfaceCache" };
+}
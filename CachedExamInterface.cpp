@@ -0,0 +1,285 @@
+#include "stdafx.h"
+#include "CachedExamInterface.h"
+#include <algorithm>
+#include "IExamInterface.h"
+#include "ConfigManager.h"
+#include "DebugOutputManager.h"
+#include "InterfaceProfiler.h"
+
+CachedExamInterface::CachedExamInterface(IExamInterface* pInterface) :
+	m_pInterface(pInterface)
+{
+}
+
+void CachedExamInterface::BeginFrame(float deltaTime)
+{
+	m_AgentInfoValid = false;
+
+	float reportInterval = ConfigManager::GetInstance()->GetInterfaceCacheReportInterval();
+	m_ReportTimer += deltaTime;
+	if (reportInterval > 0.f && m_ReportTimer >= reportInterval)
+	{
+		Report();
+		m_ReportTimer = 0.f;
+	}
+}
+
+// Cached queries
+const AgentInfo& CachedExamInterface::Agent_GetInfo()
+{
+	CountQuery(CachedQuery::AGENT_INFO, m_AgentInfoValid);
+	return FetchAgentInfo();
+}
+
+UINT CachedExamInterface::Inventory_GetCapacity()
+{
+	CountQuery(CachedQuery::INVENTORY_CAPACITY, m_InventoryCapacityValid);
+	if (!m_InventoryCapacityValid)
+	{
+		ScopedInterfaceCall call{ InterfaceCall::INVENTORY_GET_CAPACITY };
+		m_InventoryCapacity = m_pInterface->Inventory_GetCapacity();
+		m_InventoryCapacityValid = true;
+	}
+	return m_InventoryCapacity;
+}
+
+const WorldInfo& CachedExamInterface::World_GetInfo()
+{
+	CountQuery(CachedQuery::WORLD_INFO, m_WorldInfoValid);
+	if (!m_WorldInfoValid)
+	{
+		ScopedInterfaceCall call{ InterfaceCall::WORLD_GET_INFO };
+		m_WorldInfo = m_pInterface->World_GetInfo();
+		m_WorldInfoValid = true;
+	}
+	return m_WorldInfo;
+}
+
+bool CachedExamInterface::Inventory_GetItem(UINT slotId, ItemInfo& item)
+{
+	if (slotId >= m_InventorySlots.size())
+		m_InventorySlots.resize(slotId + 1);
+
+	CachedSlot& slot = m_InventorySlots[slotId];
+	CountQuery(CachedQuery::INVENTORY_ITEM, slot.valid);
+	if (!slot.valid)
+	{
+		ScopedInterfaceCall call{ InterfaceCall::INVENTORY_GET_ITEM };
+		slot.item = ItemInfo{};
+		slot.hasItem = m_pInterface->Inventory_GetItem(slotId, slot.item);
+		slot.valid = true;
+	}
+
+	if (slot.hasItem)
+		item = slot.item;
+	return slot.hasItem;
+}
+
+Elite::Vector2 CachedExamInterface::NavMesh_GetClosestPathPoint(const Elite::Vector2& goal)
+{
+	size_t capacity = ConfigManager::GetInstance()->GetNavMeshCacheCapacity();
+	if (capacity == 0)
+	{
+		ScopedInterfaceCall call{ InterfaceCall::NAVMESH_GET_CLOSEST_PATH_POINT };
+		return m_pInterface->NavMesh_GetClosestPathPoint(goal);
+	}
+
+	const Elite::Vector2& agentPos = FetchAgentInfo().Position;
+	uint64_t key = GetPathPointKey(goal, agentPos);
+	auto foundIt = m_PathPointLookup.find(key);
+
+	// The agent is standing on the corner it was sent to, the next path point has to come from the navmesh
+	float arrivalRange = ConfigManager::GetInstance()->GetNavMeshArrivalRange();
+	if (foundIt != m_PathPointLookup.end() && agentPos.DistanceSquared(foundIt->second->pathPoint) < arrivalRange * arrivalRange)
+	{
+		ErasePathPoint(foundIt->second);
+		foundIt = m_PathPointLookup.end();
+	}
+
+	CountQuery(CachedQuery::NAVMESH_PATH_POINT, foundIt != m_PathPointLookup.end());
+	if (foundIt != m_PathPointLookup.end())
+	{
+		// Move to the front, it's the most recently used now
+		m_PathPoints.splice(m_PathPoints.begin(), m_PathPoints, foundIt->second);
+		return foundIt->second->pathPoint;
+	}
+
+	Elite::Vector2 pathPoint{};
+	{
+		ScopedInterfaceCall call{ InterfaceCall::NAVMESH_GET_CLOSEST_PATH_POINT };
+		pathPoint = m_pInterface->NavMesh_GetClosestPathPoint(goal);
+	}
+
+	// Evict the least recently used queries
+	while (m_PathPoints.size() >= capacity)
+	{
+		ErasePathPoint(std::prev(m_PathPoints.end()));
+	}
+	m_PathPoints.push_front(CachedPathPoint{ key, pathPoint });
+	m_PathPointLookup[key] = m_PathPoints.begin();
+	return pathPoint;
+}
+
+// Mutating calls
+bool CachedExamInterface::Item_Grab(const EntityInfo& entity, ItemInfo& item)
+{
+	m_AgentInfoValid = false;
+	ScopedInterfaceCall call{ InterfaceCall::ITEM_GRAB };
+	return m_pInterface->Item_Grab(entity, item);
+}
+
+bool CachedExamInterface::Inventory_AddItem(UINT slotId, const ItemInfo& item)
+{
+	InvalidateSlot(slotId);
+	ScopedInterfaceCall call{ InterfaceCall::INVENTORY_ADD_ITEM };
+	return m_pInterface->Inventory_AddItem(slotId, item);
+}
+
+bool CachedExamInterface::Inventory_UseItem(UINT slotId)
+{
+	// Using an item changes its charges and the agent's vitals
+	InvalidateSlot(slotId);
+	m_AgentInfoValid = false;
+	ScopedInterfaceCall call{ InterfaceCall::INVENTORY_USE_ITEM };
+	return m_pInterface->Inventory_UseItem(slotId);
+}
+
+bool CachedExamInterface::Inventory_RemoveItem(UINT slotId)
+{
+	InvalidateSlot(slotId);
+	ScopedInterfaceCall call{ InterfaceCall::INVENTORY_REMOVE_ITEM };
+	return m_pInterface->Inventory_RemoveItem(slotId);
+}
+
+bool CachedExamInterface::Item_Destroy(const EntityInfo& entity)
+{
+	ScopedInterfaceCall call{ InterfaceCall::ITEM_DESTROY };
+	return m_pInterface->Item_Destroy(entity);
+}
+
+// Uncached calls
+bool CachedExamInterface::Fov_GetEntityByIndex(UINT index, EntityInfo& entity)
+{
+	ScopedInterfaceCall call{ InterfaceCall::FOV_GET_ENTITY_BY_INDEX };
+	return m_pInterface->Fov_GetEntityByIndex(index, entity);
+}
+
+bool CachedExamInterface::Fov_GetHouseByIndex(UINT index, HouseInfo& house)
+{
+	ScopedInterfaceCall call{ InterfaceCall::FOV_GET_HOUSE_BY_INDEX };
+	return m_pInterface->Fov_GetHouseByIndex(index, house);
+}
+
+bool CachedExamInterface::Item_GetInfo(const EntityInfo& entity, ItemInfo& item)
+{
+	ScopedInterfaceCall call{ InterfaceCall::ITEM_GET_INFO };
+	return m_pInterface->Item_GetInfo(entity, item);
+}
+
+bool CachedExamInterface::PurgeZone_GetInfo(const EntityInfo& entity, PurgeZoneInfo& zoneInfo)
+{
+	ScopedInterfaceCall call{ InterfaceCall::PURGEZONE_GET_INFO };
+	return m_pInterface->PurgeZone_GetInfo(entity, zoneInfo);
+}
+
+int CachedExamInterface::Weapon_GetAmmo(const ItemInfo& item)
+{
+	ScopedInterfaceCall call{ InterfaceCall::WEAPON_GET_AMMO };
+	return m_pInterface->Weapon_GetAmmo(item);
+}
+
+int CachedExamInterface::Food_GetEnergy(const ItemInfo& item)
+{
+	ScopedInterfaceCall call{ InterfaceCall::FOOD_GET_ENERGY };
+	return m_pInterface->Food_GetEnergy(item);
+}
+
+int CachedExamInterface::Medkit_GetHealth(const ItemInfo& item)
+{
+	ScopedInterfaceCall call{ InterfaceCall::MEDKIT_GET_HEALTH };
+	return m_pInterface->Medkit_GetHealth(item);
+}
+
+const char* CachedExamInterface::GetQueryName(CachedQuery query)
+{
+	switch (query)
+	{
+	case CachedQuery::AGENT_INFO:
+		return "Agent_GetInfo";
+	case CachedQuery::INVENTORY_CAPACITY:
+		return "Inventory_GetCapacity";
+	case CachedQuery::WORLD_INFO:
+		return "World_GetInfo";
+	case CachedQuery::INVENTORY_ITEM:
+		return "Inventory_GetItem";
+	case CachedQuery::NAVMESH_PATH_POINT:
+		return "NavMesh_GetClosestPathPoint";
+	default:
+		return "Unknown";
+	}
+}
+
+const AgentInfo& CachedExamInterface::FetchAgentInfo()
+{
+	if (!m_AgentInfoValid)
+	{
+		ScopedInterfaceCall call{ InterfaceCall::AGENT_GET_INFO };
+		m_AgentInfo = m_pInterface->Agent_GetInfo();
+		m_AgentInfoValid = true;
+	}
+	return m_AgentInfo;
+}
+
+void CachedExamInterface::CountQuery(CachedQuery query, bool hit)
+{
+	QueryCounter& counter = m_Counters[static_cast<int>(query)];
+	if (hit)
+		++counter.hits;
+	else
+		++counter.misses;
+}
+
+void CachedExamInterface::InvalidateSlot(UINT slotId)
+{
+	if (slotId < m_InventorySlots.size())
+		m_InventorySlots[slotId].valid = false;
+}
+
+uint64_t CachedExamInterface::GetPathPointKey(const Elite::Vector2& goal, const Elite::Vector2& agentPos) const
+{
+	// The path point depends on where the agent stands, so the agent's cell is part of the key
+	ConfigManager* pConfig = ConfigManager::GetInstance();
+	float goalResolution = pConfig->GetNavMeshGoalResolution();
+	float agentCellSize = pConfig->GetNavMeshAgentCellSize();
+
+	// 16 bits per coordinate, clamped so positions far outside the world share the edge cells instead of overflowing
+	auto quantize = [](float value, float cellSize) -> uint64_t
+	{
+		float cell = std::clamp(floorf(value / cellSize), static_cast<float>(INT16_MIN), static_cast<float>(INT16_MAX));
+		return static_cast<uint16_t>(static_cast<int16_t>(cell));
+	};
+	return quantize(goal.x, goalResolution) | quantize(goal.y, goalResolution) << 16
+		| quantize(agentPos.x, agentCellSize) << 32 | quantize(agentPos.y, agentCellSize) << 48;
+}
+
+void CachedExamInterface::ErasePathPoint(std::list<CachedPathPoint>::iterator it)
+{
+	m_PathPointLookup.erase(it->key);
+	m_PathPoints.erase(it);
+}
+
+void CachedExamInterface::Report()
+{
+	if (!DebugOutputManager::GetInstance()->IsDebugTypeEnabled(DebugOutputManager::DebugType::INTERFACE))
+		return;
+
+	// Hits are interface calls that never happened
+	for (int query{ 0 }; query < static_cast<int>(CachedQuery::COUNT); ++query)
+	{
+		const QueryCounter& counter = m_Counters[query];
+		char line[128];
+		snprintf(line, sizeof(line), "%s: %u hits, %u calls\n",
+			GetQueryName(static_cast<CachedQuery>(query)), counter.hits, counter.misses);
+		DebugOutputManager::GetInstance()->DebugLine(line, DebugOutputManager::DebugType::INTERFACE);
+	}
+}
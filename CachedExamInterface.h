@@ -0,0 +1,112 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "Exam_HelperStructs.h"
+
+class IExamInterface;
+
+// Interface queries the cache answers, used to index the hit counters
+enum class CachedQuery
+{
+	AGENT_INFO,
+	INVENTORY_CAPACITY,
+	WORLD_INFO,
+	INVENTORY_ITEM,
+	NAVMESH_PATH_POINT,
+	COUNT
+};
+
+// Sits between the agent and the IExamInterface for the queries that are repeated within a frame
+// Agent info is kept for one frame, inventory slots until they are changed through this cache and
+// the inventory capacity and world info for the whole session
+// Navmesh queries are kept in an LRU cache keyed on the quantized goal and the cell the agent is in,
+// a path point the agent has reached is queried again so the agent is never sent to where it already stands
+// Every host call of the agent's logic goes through here, which is also where the InterfaceProfiler times them
+// Drawing and input are left to GetInterface()
+class CachedExamInterface final
+{
+public:
+	explicit CachedExamInterface(IExamInterface* pInterface);
+
+	// Call once at the start of every tick, drops the per frame results
+	void BeginFrame(float deltaTime);
+
+	// Cached queries
+	const AgentInfo& Agent_GetInfo();
+	UINT Inventory_GetCapacity();
+	const WorldInfo& World_GetInfo();
+	bool Inventory_GetItem(UINT slotId, ItemInfo& item);
+	Elite::Vector2 NavMesh_GetClosestPathPoint(const Elite::Vector2& goal);
+
+	// Mutating calls, forwarded to the interface and invalidating what they change
+	bool Item_Grab(const EntityInfo& entity, ItemInfo& item);
+	bool Inventory_AddItem(UINT slotId, const ItemInfo& item);
+	bool Inventory_UseItem(UINT slotId);
+	bool Inventory_RemoveItem(UINT slotId);
+	bool Item_Destroy(const EntityInfo& entity);
+
+	// Uncached calls, forwarded so they are profiled
+	bool Fov_GetEntityByIndex(UINT index, EntityInfo& entity);
+	bool Fov_GetHouseByIndex(UINT index, HouseInfo& house);
+	bool Item_GetInfo(const EntityInfo& entity, ItemInfo& item);
+	bool PurgeZone_GetInfo(const EntityInfo& entity, PurgeZoneInfo& zoneInfo);
+	int Weapon_GetAmmo(const ItemInfo& item);
+	int Food_GetEnergy(const ItemInfo& item);
+	int Medkit_GetHealth(const ItemInfo& item);
+
+	IExamInterface* GetInterface() const { return m_pInterface; };
+
+	uint32_t GetHitCount(CachedQuery query) const { return m_Counters[static_cast<int>(query)].hits; };
+	uint32_t GetMissCount(CachedQuery query) const { return m_Counters[static_cast<int>(query)].misses; };
+	static const char* GetQueryName(CachedQuery query);
+private:
+	struct QueryCounter
+	{
+		uint32_t hits{ 0 };
+		uint32_t misses{ 0 };
+	};
+
+	struct CachedSlot
+	{
+		ItemInfo item{};
+		bool valid{ false };
+		bool hasItem{ false };
+	};
+
+	IExamInterface* m_pInterface = nullptr; // Not owned
+
+	// Per frame
+	AgentInfo m_AgentInfo{};
+	bool m_AgentInfoValid{ false };
+
+	// Until changed through the cache
+	std::vector<CachedSlot> m_InventorySlots{};
+
+	// Per session
+	UINT m_InventoryCapacity{ 0 };
+	bool m_InventoryCapacityValid{ false };
+	WorldInfo m_WorldInfo{};
+	bool m_WorldInfoValid{ false };
+
+	// Navmesh, most recently used first
+	struct CachedPathPoint
+	{
+		uint64_t key;
+		Elite::Vector2 pathPoint;
+	};
+	std::list<CachedPathPoint> m_PathPoints{};
+	std::unordered_map<uint64_t, std::list<CachedPathPoint>::iterator> m_PathPointLookup{};
+
+	QueryCounter m_Counters[static_cast<int>(CachedQuery::COUNT)]{};
+	float m_ReportTimer{ 0.f };
+
+	// Agent info without counting it as a query, for lookups the cache does itself
+	const AgentInfo& FetchAgentInfo();
+	void CountQuery(CachedQuery query, bool hit);
+	void InvalidateSlot(UINT slotId);
+	uint64_t GetPathPointKey(const Elite::Vector2& goal, const Elite::Vector2& agentPos) const;
+	void ErasePathPoint(std::list<CachedPathPoint>::iterator it);
+	void Report();
+};
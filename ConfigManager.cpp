@@ -32,3 +32,203 @@ bool ConfigManager::GetDebugDistantGoalPosition() const
 {
 	return m_DebugDistantGoalPosition;
 }
+
+bool ConfigManager::GetRecordWorldStateHistory() const
+{
+	return m_RecordWorldStateHistory;
+}
+
+size_t ConfigManager::GetWorldStateHistoryCapacity() const
+{
+	return m_WorldStateHistoryCapacity;
+}
+
+const std::string& ConfigManager::GetWorldStateHistoryFile() const
+{
+	return m_WorldStateHistoryFile;
+}
+
+bool ConfigManager::GetDoubleBufferedBlackboard() const
+{
+	return m_DoubleBufferedBlackboard;
+}
+
+bool ConfigManager::GetEventDrivenFSM() const
+{
+	return m_EventDrivenFSM;
+}
+
+bool ConfigManager::GetStaticFSM() const
+{
+	return m_StaticFSM;
+}
+
+bool ConfigManager::GetCoroutineActions() const
+{
+	return m_CoroutineActions;
+}
+
+int ConfigManager::GetInstantActionBudget() const
+{
+	return m_InstantActionBudget;
+}
+
+float ConfigManager::GetPlannerInterval() const
+{
+	return m_PlannerInterval;
+}
+
+float ConfigManager::GetPathRefreshInterval() const
+{
+	return m_PathRefreshInterval;
+}
+
+float ConfigManager::GetNavMeshRefreshInterval() const
+{
+	return m_NavMeshRefreshInterval;
+}
+
+float ConfigManager::GetSeekLocationInterval() const
+{
+	return m_SeekLocationInterval;
+}
+
+float ConfigManager::GetFastScoutInterval() const
+{
+	return m_FastScoutInterval;
+}
+
+float ConfigManager::GetSchedulerReportInterval() const
+{
+	return m_SchedulerReportInterval;
+}
+
+float ConfigManager::GetAIFrameBudget() const
+{
+	return m_AIFrameBudget;
+}
+
+float ConfigManager::GetLODStepUpRatio() const
+{
+	return m_LODStepUpRatio;
+}
+
+float ConfigManager::GetLODMinTierDuration() const
+{
+	return m_LODMinTierDuration;
+}
+
+float ConfigManager::GetLODReportInterval() const
+{
+	return m_LODReportInterval;
+}
+
+float ConfigManager::GetInterfaceCacheReportInterval() const
+{
+	return m_InterfaceCacheReportInterval;
+}
+
+bool ConfigManager::GetProfileInterface() const
+{
+	return m_ProfileInterface;
+}
+
+const std::string& ConfigManager::GetInterfaceProfileFile() const
+{
+	return m_InterfaceProfileFile;
+}
+
+const std::string& ConfigManager::GetInterfaceHistogramFile() const
+{
+	return m_InterfaceHistogramFile;
+}
+
+size_t ConfigManager::GetNavMeshCacheCapacity() const
+{
+	return m_NavMeshCacheCapacity;
+}
+
+float ConfigManager::GetNavMeshGoalResolution() const
+{
+	return m_NavMeshGoalResolution;
+}
+
+float ConfigManager::GetNavMeshAgentCellSize() const
+{
+	return m_NavMeshAgentCellSize;
+}
+
+float ConfigManager::GetNavMeshArrivalRange() const
+{
+	return m_NavMeshArrivalRange;
+}
+
+int ConfigManager::GetScoutProbesPerFrame() const
+{
+	return m_ScoutProbesPerFrame;
+}
+
+float ConfigManager::GetWorldMemoryCellSize() const
+{
+	return m_WorldMemoryCellSize;
+}
+
+size_t ConfigManager::GetMaxRememberedItems() const
+{
+	return m_MaxRememberedItems;
+}
+
+size_t ConfigManager::GetMaxRememberedHouses() const
+{
+	return m_MaxRememberedHouses;
+}
+
+size_t ConfigManager::GetMaxRememberedCorners() const
+{
+	return m_MaxRememberedCorners;
+}
+
+size_t ConfigManager::GetItemEvictionWindow() const
+{
+	return m_ItemEvictionWindow;
+}
+
+float ConfigManager::GetWorldMemoryReportInterval() const
+{
+	return m_WorldMemoryReportInterval;
+}
+
+float ConfigManager::GetSeekItemWeight() const
+{
+	return m_SeekItemWeight;
+}
+
+float ConfigManager::GetSeekHouseWeight() const
+{
+	return m_SeekHouseWeight;
+}
+
+float ConfigManager::GetSeekCornerWeight() const
+{
+	return m_SeekCornerWeight;
+}
+
+size_t ConfigManager::GetSeekTargetCount() const
+{
+	return m_SeekTargetCount;
+}
+
+float ConfigManager::GetLootTourRadius() const
+{
+	return m_LootTourRadius;
+}
+
+size_t ConfigManager::GetLootTourMaxStops() const
+{
+	return m_LootTourMaxStops;
+}
+
+float ConfigManager::GetLootTourBudget() const
+{
+	return m_LootTourBudget;
+}
\ No newline at end of file
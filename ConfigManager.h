@@ -1,4 +1,6 @@
 #pragma once
+#include <string>
+
 class ConfigManager
 {
 public:
@@ -19,6 +21,72 @@ public:
 	bool GetDebugSteering() const;
 	bool GetDebugGoalPosition() const;
 	bool GetDebugDistantGoalPosition() const;
+
+	// WorldState history recording
+	bool GetRecordWorldStateHistory() const;
+	size_t GetWorldStateHistoryCapacity() const;
+	const std::string& GetWorldStateHistoryFile() const;
+
+	// Blackboard
+	bool GetDoubleBufferedBlackboard() const;
+
+	// Decision making
+	bool GetEventDrivenFSM() const;
+	bool GetStaticFSM() const;
+	bool GetCoroutineActions() const;
+	// Maximum amount of instantaneous actions performed in the same frame, 0 disables chaining
+	int GetInstantActionBudget() const;
+
+	// Tick scheduler, intervals in seconds
+	float GetPlannerInterval() const;
+	float GetPathRefreshInterval() const;
+	float GetNavMeshRefreshInterval() const;
+	float GetSeekLocationInterval() const;
+	float GetFastScoutInterval() const;
+	// Seconds between reports of the actual rates and costs, 0 disables reporting
+	float GetSchedulerReportInterval() const;
+
+	// AI level of detail
+	float GetAIFrameBudget() const; // ms the agent's update may take
+	float GetLODStepUpRatio() const; // Fraction of the budget the average has to drop below to step back up
+	float GetLODMinTierDuration() const;
+	float GetLODReportInterval() const;
+
+	// Interface cache, seconds between hit counter reports, 0 disables reporting
+	float GetInterfaceCacheReportInterval() const;
+	// Navmesh probes GOAPFastHouseScout may do per frame, 0 does the whole scout in one frame
+	int GetScoutProbesPerFrame() const;
+	// Navmesh query cache, a capacity of 0 disables it
+	size_t GetNavMeshCacheCapacity() const;
+	float GetNavMeshGoalResolution() const; // Goals closer than this share a cache entry
+	float GetNavMeshAgentCellSize() const;
+	// Cached path points closer to the agent than this are queried again, the agent already reached them
+	float GetNavMeshArrivalRange() const;
+	// Interface profiler, per frame call counts and session histograms
+	bool GetProfileInterface() const;
+	const std::string& GetInterfaceProfileFile() const;
+	const std::string& GetInterfaceHistogramFile() const;
+
+	// World memory, side of the spatial grid cells
+	float GetWorldMemoryCellSize() const;
+	// Caps per category, 0 disables the cap
+	size_t GetMaxRememberedItems() const;
+	size_t GetMaxRememberedHouses() const;
+	size_t GetMaxRememberedCorners() const;
+	size_t GetItemEvictionWindow() const; // Least recently seen items the furthest is evicted from
+	// Seconds between footprint reports, 0 disables reporting
+	float GetWorldMemoryReportInterval() const;
+
+	// Seek targets, the squared distance to a candidate is multiplied by its weight
+	float GetSeekItemWeight() const;
+	float GetSeekHouseWeight() const;
+	float GetSeekCornerWeight() const; // Corners only compete with other corners
+	size_t GetSeekTargetCount() const; // Best targets kept per scoring
+
+	// Loot tours, items within the radius are ordered into one route
+	float GetLootTourRadius() const;
+	size_t GetLootTourMaxStops() const;
+	float GetLootTourBudget() const; // ms the 2-opt improvement may take
 private:
 	ConfigManager() = default;
 
@@ -28,5 +96,54 @@ private:
 	bool m_DebugSteering = false;
 	bool m_DebugGoalPosition = true;
 	bool m_DebugDistantGoalPosition = true;
+
+	bool m_RecordWorldStateHistory = false;
+	size_t m_WorldStateHistoryCapacity = 16384;
+	std::string m_WorldStateHistoryFile = "WorldStateHistory.bin";
+
+	bool m_DoubleBufferedBlackboard = false;
+
+	bool m_EventDrivenFSM = true;
+	bool m_StaticFSM = false;
+	bool m_CoroutineActions = true;
+	int m_InstantActionBudget = 4;
+
+	float m_PlannerInterval = 1.f;
+	float m_PathRefreshInterval = .1f;
+	float m_NavMeshRefreshInterval = 1.f;
+	float m_SeekLocationInterval = .25f;
+	float m_FastScoutInterval = 3.f;
+	float m_SchedulerReportInterval = 5.f;
+
+	float m_AIFrameBudget = 2.f;
+	float m_LODStepUpRatio = .5f;
+	float m_LODMinTierDuration = 1.f;
+	float m_LODReportInterval = 10.f;
+
+	float m_InterfaceCacheReportInterval = 10.f;
+	int m_ScoutProbesPerFrame = 6;
+	size_t m_NavMeshCacheCapacity = 256;
+	float m_NavMeshGoalResolution = 1.f;
+	float m_NavMeshAgentCellSize = 4.f;
+	float m_NavMeshArrivalRange = 3.5f;
+	bool m_ProfileInterface = false;
+	std::string m_InterfaceProfileFile = "InterfaceProfile.csv";
+	std::string m_InterfaceHistogramFile = "InterfaceHistograms.txt";
+
+	float m_WorldMemoryCellSize = 20.f;
+	size_t m_MaxRememberedItems = 256;
+	size_t m_MaxRememberedHouses = 64;
+	size_t m_MaxRememberedCorners = 128;
+	size_t m_ItemEvictionWindow = 8;
+	float m_WorldMemoryReportInterval = 10.f;
+
+	float m_SeekItemWeight = 1.f;
+	float m_SeekHouseWeight = 1.f;
+	float m_SeekCornerWeight = 1.f;
+	size_t m_SeekTargetCount = 4;
+
+	float m_LootTourRadius = 40.f;
+	size_t m_LootTourMaxStops = 10;
+	float m_LootTourBudget = .2f;
 };
 
@@ -48,6 +48,18 @@ void DebugOutputManager::DebugLine(const std::string& line, DebugType debugType)
 		debug = m_DebugWorldState;
 		SetConsoleTextAttribute(hConsole, int(TextColor::BLUE));
 		break;
+	case DebugType::SCHEDULER:
+		debug = m_DebugScheduler;
+		break;
+	case DebugType::LEVEL_OF_DETAIL:
+		debug = m_DebugLevelOfDetail;
+		break;
+	case DebugType::INTERFACE:
+		debug = m_DebugInterface;
+		break;
+	case DebugType::MEMORY:
+		debug = m_DebugMemory;
+		break;
 	default:
 		debug = true;
 		break;
@@ -58,3 +70,38 @@ void DebugOutputManager::DebugLine(const std::string& line, DebugType debugType)
 		std::cout << line;
 	}
 }
+
+bool DebugOutputManager::IsDebugTypeEnabled(DebugType debugType) const
+{
+	if (!m_DebuggingAllowed) return false;
+
+	switch (debugType)
+	{
+	case DebugType::FSM_STATE:
+		return m_DebugFSMState;
+	case DebugType::GOAP_PLANNER:
+		return m_DebugGOAPPlanner;
+	case DebugType::GOAP_ACTION:
+		return m_DebugGOAPAction;
+	case DebugType::SEARCH_ALGORITHM:
+		return m_DebugSearchAlgorithm;
+	case DebugType::PROBLEM:
+		return m_DebugProblem;
+	case DebugType::INVENTORY:
+		return m_DebugInventory;
+	case DebugType::STEERING:
+		return m_DebugSteering;
+	case DebugType::WORLDSTATE:
+		return m_DebugWorldState;
+	case DebugType::SCHEDULER:
+		return m_DebugScheduler;
+	case DebugType::LEVEL_OF_DETAIL:
+		return m_DebugLevelOfDetail;
+	case DebugType::INTERFACE:
+		return m_DebugInterface;
+	case DebugType::MEMORY:
+		return m_DebugMemory;
+	default:
+		return true;
+	}
+}
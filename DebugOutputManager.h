@@ -15,6 +15,10 @@ public:
 		INVENTORY,
 		STEERING,
 		WORLDSTATE,
+		SCHEDULER,
+		LEVEL_OF_DETAIL,
+		INTERFACE,
+		MEMORY,
 		PROBLEM
 	};
 
@@ -28,6 +32,8 @@ public:
 	}
 
 	void DebugLine(const std::string& line, DebugType debugType);
+	// Lets callers skip building expensive debug strings that would never be printed
+	bool IsDebugTypeEnabled(DebugType debugType) const;
 
 	static DebugOutputManager* instance;
 private:
@@ -54,6 +60,10 @@ private:
 	bool m_DebugInventory = false;
 	bool m_DebugSteering = false;
 	bool m_DebugWorldState = false;
+	bool m_DebugScheduler = false;
+	bool m_DebugLevelOfDetail = false;
+	bool m_DebugInterface = false;
+	bool m_DebugMemory = false;
 	bool m_DebugProblem = true;
 };
 
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+// Events raised by the planner and the actions. In event driven mode the FSM only evaluates
+// the transitions listening to one of the events raised since its last update
+typedef uint32_t FSMEventMask;
+namespace FSMEvent
+{
+	const FSMEventMask NONE = 0;
+	const FSMEventMask ACTION_CHANGED = 1 << 0; // The planner has a new current action
+	const FSMEventMask MOVEMENT_REQUIRED = 1 << 1; // The current action needs to move before it can continue performing
+	const FSMEventMask MOVEMENT_FULFILLED = 1 << 2; // The current action doesn't require any more movement
+	const FSMEventMask ACTION_DONE = 1 << 3; // IsDone of the current action has to be checked
+	const FSMEventMask PROBLEM_ENCOUNTERED = 1 << 4;
+	const FSMEventMask ALL = 0xFFFFFFFF;
+}
@@ -10,37 +10,52 @@
 #include "FSMState.h"
 #include "IExamInterface.h"
 #include "DebugOutputManager.h"
+#include "GOAPPlanner.h"
 
 FiniteStateMachine::FiniteStateMachine(FSMState* startState, IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
 	: m_pCurrentState(nullptr),
 	m_pBlackboard(pBlackboard)
 {
-	SetState(pInterface, pPlanner, startState);
+	SetState(pInterface, pPlanner, GetStateId(startState));
 }
 
 void FiniteStateMachine::AddTransition(FSMState* startState, FSMState* toState, FSMTransition* transition)
 {
-	auto it = m_Transitions.find(startState);
-	if (it == m_Transitions.end())
+	int startStateId = GetStateId(startState);
+	int toStateId = GetStateId(toState);
+
+	// Insert behind the other transitions of the start state and shift the ranges of the states stored after it
+	StateEntry& startEntry = m_States[startStateId];
+	size_t insertIndex = startEntry.firstTransition + startEntry.transitionCount;
+	m_TransitionTable.insert(m_TransitionTable.begin() + insertIndex, TransitionEntry{ transition, toStateId, transition->GetTriggerEvents() });
+	++startEntry.transitionCount;
+
+	for (StateEntry& stateEntry : m_States)
 	{
-		m_Transitions[startState] = Transitions();
+		if (&stateEntry != &startEntry && stateEntry.firstTransition >= insertIndex)
+			++stateEntry.firstTransition;
 	}
-
-	m_Transitions[startState].push_back(std::make_pair(transition, toState));
 }
 
 void FiniteStateMachine::Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, float deltaTime)
 {
-	auto it = m_Transitions.find(m_pCurrentState);
-	if (it != m_Transitions.end())
+	// Events raised after this point (by OnEnter or the state update) are handled next update
+	FSMEventMask pendingEvents = m_EventDriven ? pPlanner->ConsumeEvents() : FSMEvent::ALL;
+
+	if (m_CurrentStateId >= 0 && pendingEvents != FSMEvent::NONE)
 	{
 		//Since we use a normal for loop to loop over all the transitions
 		//the order that you add the transitions is the order of importance
-		for (TransitionStatePair& transPair : it->second)
+		const StateEntry& stateEntry = m_States[m_CurrentStateId];
+		const TransitionEntry* pTransitions = m_TransitionTable.data() + stateEntry.firstTransition;
+		for (size_t i{ 0 }; i < stateEntry.transitionCount; ++i)
 		{
-			if (transPair.first->ToTransition(pInterface, pPlanner, m_pBlackboard))
+			if ((pTransitions[i].triggerEvents & pendingEvents) == 0)
+				continue;
+
+			if (pTransitions[i].pTransition->ToTransition(pInterface, pPlanner, m_pBlackboard))
 			{
-				SetState(pInterface, pPlanner, transPair.second);
+				SetState(pInterface, pPlanner, pTransitions[i].toStateId);
 				break;
 			}
 		}
@@ -55,16 +70,37 @@ Blackboard* FiniteStateMachine::GetBlackboard() const
 	return m_pBlackboard;
 }
 
-void FiniteStateMachine::SetState(IExamInterface* pInterface, GOAPPlanner* pPlanner, FSMState* newState)
+void FiniteStateMachine::SetState(IExamInterface* pInterface, GOAPPlanner* pPlanner, int newStateId)
 {
 	if (m_pCurrentState)
 		m_pCurrentState->OnExit(pInterface, pPlanner, m_pBlackboard);
-	m_pCurrentState = newState;
+	m_CurrentStateId = newStateId;
+	m_pCurrentState = newStateId >= 0 ? m_States[newStateId].pState : nullptr;
 	if (m_pCurrentState)
 	{
-		std::string stateClassName = typeid(*m_pCurrentState).name();
-		DebugOutputManager::GetInstance()->DebugLine("Entering state: " + stateClassName + "\n",
-			DebugOutputManager::DebugType::FSM_STATE);
+		// Only build the state name when it actually gets logged
+		if (DebugOutputManager::GetInstance()->IsDebugTypeEnabled(DebugOutputManager::DebugType::FSM_STATE))
+		{
+			std::string stateClassName = typeid(*m_pCurrentState).name();
+			DebugOutputManager::GetInstance()->DebugLine("Entering state: " + stateClassName + "\n",
+				DebugOutputManager::DebugType::FSM_STATE);
+		}
 		m_pCurrentState->OnEnter(pInterface, pPlanner, m_pBlackboard);
 	}
 }
+
+int FiniteStateMachine::GetStateId(FSMState* pState)
+{
+	if (!pState)
+		return -1;
+
+	// Only ran while wiring up the machine
+	for (size_t id{ 0 }; id < m_States.size(); ++id)
+	{
+		if (m_States[id].pState == pState)
+			return static_cast<int>(id);
+	}
+
+	m_States.push_back(StateEntry{ pState, m_TransitionTable.size(), 0 });
+	return static_cast<int>(m_States.size() - 1);
+}
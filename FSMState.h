@@ -2,9 +2,9 @@
 
 //--- Includes ---
 #include <vector>
-#include <map>
 #include "Blackboard.h"
 #include "DecisionMaking.h"
+#include "FSMEvents.h"
 
 class IExamInterface;
 class GOAPPlanner;
@@ -25,6 +25,9 @@ public:
 	FSMTransition() = default;
 	virtual ~FSMTransition() = default;
 	virtual bool ToTransition(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const = 0;
+	// Events that can make ToTransition return true, only used when the FSM is event driven
+	// Read once when the transition is added, so it has to return the same mask every time
+	virtual FSMEventMask GetTriggerEvents() const { return FSMEvent::ALL; };
 };
 
 class FiniteStateMachine final : public DecisionMaking
@@ -37,13 +40,31 @@ public:
 	virtual void Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, float deltaT);
 	Blackboard* GetBlackboard() const;
 
+	// Only evaluate transitions when the planner raised an event they listen to, instead of polling every update
+	void SetEventDriven(bool eventDriven) { m_EventDriven = eventDriven; };
+	bool IsEventDriven() const { return m_EventDriven; };
+
 private:
-	void SetState(IExamInterface* pInterface, GOAPPlanner* pPlanner,FSMState* newState);
+	void SetState(IExamInterface* pInterface, GOAPPlanner* pPlanner, int newStateId);
+	int GetStateId(FSMState* pState);
 private:
-	typedef std::pair<FSMTransition*, FSMState*> TransitionStatePair;
-	typedef std::vector<TransitionStatePair> Transitions;
+	struct TransitionEntry
+	{
+		FSMTransition* pTransition;
+		int toStateId;
+		FSMEventMask triggerEvents; // Cached when wiring up, skipping a transition costs no virtual call
+	};
+	struct StateEntry
+	{
+		FSMState* pState;
+		size_t firstTransition; // Index into m_TransitionTable
+		size_t transitionCount;
+	};
 
-	std::map<FSMState*, Transitions> m_Transitions; //Key is the state, value are all the transitions for that current state 
+	std::vector<StateEntry> m_States{}; // Indexed by the dense state id assigned in AddTransition
+	std::vector<TransitionEntry> m_TransitionTable{}; // Transitions of each state are stored contiguously, in order of importance
+	int m_CurrentStateId = -1;
 	FSMState* m_pCurrentState;
 	Blackboard* m_pBlackboard = nullptr; // takes ownership of the blackboard
+	bool m_EventDriven = false;
 };
\ No newline at end of file
@@ -3,10 +3,18 @@
 #include "GOAPPlanner.h"
 #include "IExamInterface.h"
 #include "Blackboard.h"
+#include "BlackboardKeys.h"
 #include "WorldState.h"
 #include "ConfigManager.h"
 #include "Agent.h"
 #include "utils.h"
+#include "TickScheduler.h"
+#include "AILevelOfDetail.h"
+#include "PerceptionSnapshot.h"
+#include "CachedExamInterface.h"
+#include "WorldMemory.h"
+#include "SeekTargetScorer.h"
+#include "LootTourPlanner.h"
 
 // ---------------------------
 // Base class GOAPAction
@@ -21,6 +29,11 @@ GOAPAction::~GOAPAction()
 {
 	Cleanup();
 }
+bool GOAPAction::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt)
+{
+	pPlanner->RaiseEvent(FSMEvent::ACTION_DONE);
+	return true;
+}
 bool GOAPAction::HasEffect(GOAPProperty* pPrecondition)
 {
 	bool hasEffect{ false };
@@ -116,7 +129,7 @@ void GOAPConsumeFood::Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner, B
 bool GOAPConsumeFood::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt)
 {
 	Agent* pAgent = nullptr;
-	bool dataValid = pBlackboard->GetData("Agent", pAgent);
+	bool dataValid = pBlackboard->GetData(BlackboardKeys::AGENT, pAgent);
 	if (!dataValid)
 		return false;
 
@@ -129,8 +142,22 @@ bool GOAPConsumeFood::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner,
 		success = m_Consumed;
 	}
 
+	// IsDone doesn't have to poll the inventory, the item is consumed after the first perform
+	if (success)
+		pPlanner->RaiseEvent(FSMEvent::ACTION_DONE);
+
 	return success;
 }
+ActionTask GOAPConsumeFood::Execute(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
+{
+	Agent* pAgent = nullptr;
+	bool dataValid = pBlackboard->GetData(BlackboardKeys::AGENT, pAgent);
+	if (!dataValid)
+		co_return false;
+
+	// The coroutine only runs once, no need for m_Consumed
+	co_return pAgent->ConsumeItem(eItemType::FOOD);
+}
 bool GOAPConsumeFood::IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const
 {
 	ApplyEffects(pInterface, pPlanner, pBlackboard);
@@ -152,13 +179,21 @@ void GOAPConsumeFood::InitEffects(GOAPPlanner* pPlanner)
 void GOAPConsumeFood::ApplyEffects(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const
 {
 	// Setup behavior to an item search behavior with priority for energy
-	int maxInventorySlots = pInterface->Inventory_GetCapacity();
+	CachedExamInterface* pInterfaceCache = nullptr;
+	if (!pBlackboard->GetData(BlackboardKeys::INTERFACE_CACHE, pInterfaceCache))
+	{
+		DebugOutputManager::GetInstance()->DebugLine("Error obtaining blackboard data in GOAPConsumeFood::ApplyEffects\n",
+			DebugOutputManager::DebugType::PROBLEM);
+		return;
+	}
+
+	int maxInventorySlots = pInterfaceCache->Inventory_GetCapacity();
 	int index{ 0 };
 	bool allFoodUsed = true;
 	while (index < maxInventorySlots)
 	{
 		ItemInfo item;
-		bool hasItem = pInterface->Inventory_GetItem(index, item);
+		bool hasItem = pInterfaceCache->Inventory_GetItem(index, item);
 		if (hasItem)
 		{
 			if (item.Type == eItemType::FOOD)
@@ -204,7 +239,7 @@ void GOAPConsumeMedkit::Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner,
 bool GOAPConsumeMedkit::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt)
 {
 	Agent* pAgent = nullptr;
-	bool dataValid = pBlackboard->GetData("Agent", pAgent);
+	bool dataValid = pBlackboard->GetData(BlackboardKeys::AGENT, pAgent);
 	if (!dataValid)
 		return false;
 
@@ -217,8 +252,22 @@ bool GOAPConsumeMedkit::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanne
 		success = m_Consumed;
 	}
 
+	// IsDone doesn't have to poll the inventory, the item is consumed after the first perform
+	if (success)
+		pPlanner->RaiseEvent(FSMEvent::ACTION_DONE);
+
 	return success;
 }
+ActionTask GOAPConsumeMedkit::Execute(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
+{
+	Agent* pAgent = nullptr;
+	bool dataValid = pBlackboard->GetData(BlackboardKeys::AGENT, pAgent);
+	if (!dataValid)
+		co_return false;
+
+	// The coroutine only runs once, no need for m_Consumed
+	co_return pAgent->ConsumeItem(eItemType::MEDKIT);
+}
 bool GOAPConsumeMedkit::IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const
 {
 	ApplyEffects(pInterface, pPlanner, pBlackboard);
@@ -240,13 +289,21 @@ void GOAPConsumeMedkit::InitEffects(GOAPPlanner* pPlanner)
 void GOAPConsumeMedkit::ApplyEffects(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const
 {
 	// Setup behavior to an item search behavior with priority for energy
-	int maxInventorySlots = pInterface->Inventory_GetCapacity();
+	CachedExamInterface* pInterfaceCache = nullptr;
+	if (!pBlackboard->GetData(BlackboardKeys::INTERFACE_CACHE, pInterfaceCache))
+	{
+		DebugOutputManager::GetInstance()->DebugLine("Error obtaining blackboard data in GOAPConsumeMedkit::ApplyEffects\n",
+			DebugOutputManager::DebugType::PROBLEM);
+		return;
+	}
+
+	int maxInventorySlots = pInterfaceCache->Inventory_GetCapacity();
 	int index{ 0 };
 	bool allMedkitsUsed = true;
 	while (index < maxInventorySlots)
 	{
 		ItemInfo item;
-		bool hasItem = pInterface->Inventory_GetItem(index, item);
+		bool hasItem = pInterfaceCache->Inventory_GetItem(index, item);
 		if (hasItem)
 		{
 			if (item.Type == eItemType::MEDKIT)
@@ -291,10 +348,14 @@ void GOAPSearchItem::Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner, Bl
 	DebugOutputManager::GetInstance()->DebugLine("Setting up GOAPSearchItem\n",
 		DebugOutputManager::DebugType::GOAP_ACTION);
 	// Setup behavior to an item search behavior with priority for energy
-	bool dataValid = pBlackboard->GetData("HouseCornerLocations", m_pHouseCornerLocations)
-		&& pBlackboard->GetData("HouseLocations", m_pHouseLocations)
-		&& pBlackboard->GetData("ItemLocations", m_pItemsOnGround)
-		&& pBlackboard->GetData("Agent", m_pAgent);
+	bool dataValid = pBlackboard->GetData(BlackboardKeys::WORLD_MEMORY, m_pWorldMemory)
+		&& pBlackboard->GetData(BlackboardKeys::SEEK_TARGETS, m_pSeekTargetScorer)
+		&& pBlackboard->GetData(BlackboardKeys::LOOT_TOUR, m_pLootTourPlanner)
+		&& pBlackboard->GetData(BlackboardKeys::AGENT, m_pAgent)
+		&& pBlackboard->GetData(BlackboardKeys::TICK_SCHEDULER, m_pTickScheduler)
+		&& pBlackboard->GetData(BlackboardKeys::LEVEL_OF_DETAIL, m_pLevelOfDetail)
+		&& pBlackboard->GetData(BlackboardKeys::PERCEPTION, m_pPerception)
+		&& pBlackboard->GetData(BlackboardKeys::INTERFACE_CACHE, m_pInterfaceCache);
 
 	if (!dataValid)
 	{
@@ -303,6 +364,9 @@ void GOAPSearchItem::Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner, Bl
 		return;
 	}
 
+	// Fetch the agent house on the first perform
+	m_AgentHouseSubscription.Reset();
+
 	ChooseSeekLocation(pInterface, pPlanner, pBlackboard);
 
 
@@ -314,66 +378,48 @@ void GOAPSearchItem::Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner, Bl
 bool GOAPSearchItem::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt)
 {
 	m_IsDoneTimer += dt;
+	// Derived searches finish on their own IsDone
+	if (IsDone(pInterface, pPlanner, pBlackboard))
+		pPlanner->RaiseEvent(FSMEvent::ACTION_DONE);
 	if (!utils::VitalStatisticsAreOk(m_pWorldState))
 		return false;
 
-	// Get blackboard data
-	pBlackboard->GetData("AgentHouse", m_AgentHouse);
+	// Get blackboard data, the agent house only has to be fetched again when it changed
+	if (m_AgentHouseSubscription.ConsumeChange(pBlackboard))
+		pBlackboard->GetData(BlackboardKeys::AGENT_HOUSE, m_AgentHouse);
 	bool requiresNewSeekPos{ false };
 
 	// Get the info from the agent
-	const AgentInfo& agentInfo = pInterface->Agent_GetInfo();
+	const AgentInfo& agentInfo = m_pInterfaceCache->Agent_GetInfo();
 
 	// Remove old purgezones
-	m_PurgesZonesInSight.erase(std::remove_if(m_PurgesZonesInSight.begin(), m_PurgesZonesInSight.end(), [](SpottedPurgeZone& spz)
-		{
-			return spz.timeSinceSpotted > 3.f;
-		}), m_PurgesZonesInSight.end()
-			);
+	m_pWorldMemory->UpdatePurgeZones(dt, m_PurgeZoneMemoryTime);
 
 	// Check for items and purgezones
 	bool isInPurgeZone{ false };
-	auto vEntitiesInFov = utils::GetEntitiesInFOV(pInterface);
-	for (EntityInfo& entity : vEntitiesInFov)
+	int purgeZoneCheckStride = m_pLevelOfDetail ? m_pLevelOfDetail->GetPurgeZoneCheckStride() : 1;
+	bool checkPurgeZones = (++m_PurgeZoneCheckFrame % purgeZoneCheckStride) == 0;
+	for (const PerceivedItem& item : m_pPerception->GetItems())
 	{
-		if (entity.Type == eEntityType::ITEM)
+		// If we got item info
+		// New item found! Remember it unless we already know it
+		if (item.hasInfo && m_pWorldMemory->AddItem(item.entity, item.info.Type))
 		{
-			ItemInfo itemInfo;
-			// If we got item info
-			if (pInterface->Item_GetInfo(entity, itemInfo))
-			{
-				// See if we already know the item
-				auto foundIt = std::find_if(m_pItemsOnGround->begin(), m_pItemsOnGround->end(), [&itemInfo](EntityInfo& item)
-					{
-						float distanceSquared = item.Location.DistanceSquared(itemInfo.Location);
-						return distanceSquared < 1.f;
-					}
-				);
-
-				// New item found! Add the item to the array
-				if (foundIt == m_pItemsOnGround->end())
-				{
-					DebugOutputManager::GetInstance()->DebugLine("Item found!\n",
-						DebugOutputManager::DebugType::GOAP_ACTION);
-					m_pItemsOnGround->push_back(entity);
-					requiresNewSeekPos = true;
-				}
-			}
+			DebugOutputManager::GetInstance()->DebugLine("Item found!\n",
+				DebugOutputManager::DebugType::GOAP_ACTION);
+			requiresNewSeekPos = true;
 		}
-		else if (entity.Type == eEntityType::PURGEZONE)
+	}
+	// Items we should be seeing but aren't were taken
+	m_pWorldMemory->ForgetUnseenItems(agentInfo);
+	if (checkPurgeZones)
+	{
+		for (const PerceivedPurgeZone& purgeZone : m_pPerception->GetPurgeZones())
 		{
-			PurgeZoneInfo pzi;
-			pInterface->PurgeZone_GetInfo(entity, pzi);
-
-			auto findPurgezone = std::find_if(m_PurgesZonesInSight.begin(), m_PurgesZonesInSight.end(), [&pzi](const SpottedPurgeZone& spz)
-				{
-					return spz.purgezoneInfo.Center == pzi.Center;
-				}
-			);
+			const PurgeZoneInfo& pzi = purgeZone.info;
 
 			// Add the newly found purgezone
-			if (findPurgezone == m_PurgesZonesInSight.end())
-				m_PurgesZonesInSight.push_back(SpottedPurgeZone{ pzi, 0.f });
+			m_pWorldMemory->AddPurgeZone(pzi);
 
 			// Make the action seek a new position if the agent happened to be inside of the purge zone
 			if (utils::IsPointInCircle(agentInfo.Position, pzi.Center, pzi.Radius))
@@ -384,48 +430,37 @@ bool GOAPSearchItem::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner,
 		}
 	}
 
-	// Try to loot items on the ground
-	if (m_pItemsOnGround->size() > 0)
+	// Try to loot the items on the ground within grab range
+	m_ItemsInRange.clear();
+	m_pWorldMemory->QueryItems(agentInfo.Position, agentInfo.GrabRange, m_ItemsInRange);
+	if (m_ItemsInRange.size() > 0)
 	{
-		int startSize = m_pItemsOnGround->size();
-		std::vector<EntityInfo*> grabbedItems{};
-		for (EntityInfo& i : *m_pItemsOnGround)
+		m_GrabbedItems.clear();
+		for (ItemHandle handle : m_ItemsInRange)
 		{
-			bool grabError = false;
-			bool itemPickedUp = m_pAgent->GrabItem(i, pInterface);
+			RememberedItem rememberedItem{};
+			if (!m_pWorldMemory->GetItem(handle, rememberedItem))
+				continue;
+
+			EntityInfo& item = rememberedItem.entity;
+			bool itemPickedUp = m_pAgent->GrabItem(item, pInterface);
 			if (itemPickedUp)
 			{
-				grabbedItems.push_back(&i);
+				m_GrabbedItems.push_back(handle);
 				requiresNewSeekPos = true;
-				m_ItemLootedPosition = i.Location;
-
-				for (ExploredHouse& h : *m_pHouseLocations)
-				{
-					++h.itemsLootedSinceExplored;
-				}
+				m_ItemLootedPosition = item.Location;
+				m_pWorldMemory->OnItemLooted();
 			}
 		}
 
-		if (grabbedItems.size() > 0)
-		{
-			// Remove all the grabbed items from the items on ground list
-			m_pItemsOnGround->erase(std::remove_if(m_pItemsOnGround->begin(), m_pItemsOnGround->end(), [&grabbedItems](EntityInfo& e)
-				{
-					for (EntityInfo* grabbedItem : grabbedItems)
-					{
-						if (grabbedItem->Location == e.Location)
-						{
-							return true;
-						}
-					}
-					return false;
-				}
-			), m_pItemsOnGround->end());
-		}
+		// Remove all the grabbed items from the remembered items
+		if (m_GrabbedItems.size() > 0)
+			m_pWorldMemory->RemoveItems(m_GrabbedItems);
 	}
 
-	auto vHousesInFOV = utils::GetHousesInFOV(pInterface);
-	pBlackboard->ChangeData("AgentInPurgeZone", isInPurgeZone);
+	// Keep the last result on frames that skipped the purge zone scan
+	if (checkPurgeZones)
+		pBlackboard->ChangeData(BlackboardKeys::AGENT_IN_PURGE_ZONE, isInPurgeZone);
 
 	// Go into kill behavior if we're not in a house and we have a weapon
 	if (m_pWorldState->IsStateMet("HasWeapon", true) /*&& !m_AgentHouse*/)
@@ -439,22 +474,13 @@ bool GOAPSearchItem::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner,
 	}
 
 	// Check for new houses
-	for (HouseInfo& house : vHousesInFOV)
+	for (const HouseInfo& house : m_pPerception->GetHouses())
 	{
-		// See if we have already memorized the house location
-		auto foundIterator = std::find_if(m_pHouseLocations->begin(), m_pHouseLocations->end(), [&house](ExploredHouse& exploredHouse)
-			{
-				return house.Center == exploredHouse.houseInfo.Center;
-			}
-		);
-
-		// House does not exist yet
-		if (foundIterator == m_pHouseLocations->end())
+		// Add the house to the known locations if we haven't memorized it yet
+		if (m_pWorldMemory->AddHouse(house))
 		{
-			// Add the house to the known locations
-			m_pHouseLocations->push_back(ExploredHouse{ house, 999 });
 			// Remove all corner locations of this house
-			RemoveExploredCornerLocations(house);
+			m_pWorldMemory->RemoveCornersNearHouse(house, m_CornerRemovalMargin);
 			// Choose a new seek location
 			requiresNewSeekPos = true;
 		}
@@ -465,31 +491,39 @@ bool GOAPSearchItem::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner,
 	{
 		ChooseSeekLocation(pInterface, pPlanner, pBlackboard);
 	}
-	else if (CheckArrival(pInterface, pPlanner, pBlackboard))
+	else if (CheckArrival(pInterface, pPlanner, pBlackboard) && m_pTickScheduler
+		&& m_pTickScheduler->TryRun(ScheduledTask::SEEK_LOCATION))
 	{
-		if (m_ChooseSeekLocationTimer > m_ChooseSeekLocationTime)
-		{
-			ChooseSeekLocation(pInterface, pPlanner, pBlackboard);
-			m_ChooseSeekLocationTimer = 0.f;
-		}
+		ScopedTaskCost taskCost{ m_pTickScheduler, ScheduledTask::SEEK_LOCATION };
+		ChooseSeekLocation(pInterface, pPlanner, pBlackboard);
 	}
-	m_ChooseSeekLocationTimer += dt;
 
-	// Update time for spotted purgezones
-	for (SpottedPurgeZone& spz : m_PurgesZonesInSight)
-	{
-		spz.timeSinceSpotted += dt;
-	}
+	// Skip debug draws at lower detail
+	if (m_pLevelOfDetail && !m_pLevelOfDetail->AllowDebugDraw())
+		return true;
 
-	// Debug goal
+	// Debug goal and the runner up targets
 	if (ConfigManager::GetInstance()->GetDebugGoalPosition())
+	{
 		pInterface->Draw_SolidCircle(m_pAgent->GetGoalPosition(), 3.f, {}, { 0.f,1.f,0.f });
+		for (const SeekTarget& target : m_pSeekTargetScorer->GetTargets())
+		{
+			pInterface->Draw_Circle(target.location, 1.5f, { 0.f,1.f,0.f });
+		}
+
+		// Remaining loot tour
+		const std::vector<Elite::Vector2>& route = m_pLootTourPlanner->GetRoute();
+		for (size_t i{ 1 }; i < route.size(); ++i)
+		{
+			pInterface->Draw_Segment(route[i - 1], route[i], { 0.f,1.f,0.f });
+		}
+	}
 	// Debug corner locations
 	if (ConfigManager::GetInstance()->GetDebugHouseCornerLocations())
 	{
-		for (const Elite::Vector2& c : *m_pHouseCornerLocations)
+		for (uint32_t i{ 0 }; i < m_pWorldMemory->GetCornerCount(); ++i)
 		{
-			pInterface->Draw_SolidCircle(c, 2.f, {}, { 0.f,0.f,1.f });
+			pInterface->Draw_SolidCircle(m_pWorldMemory->GetCorner(i), 2.f, {}, { 0.f,0.f,1.f });
 		}
 	}
 	// Debug distant goal
@@ -514,176 +548,74 @@ void GOAPSearchItem::InitEffects(GOAPPlanner* pPlanner)
 }
 void GOAPSearchItem::ChooseSeekLocation(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
 {
-	const Elite::Vector2& agentPos = pInterface->Agent_GetInfo().Position;
-	Elite::Vector2 destination{};
-	bool foundPath = false;
-
-	// Find path to item
-	float closestItemDistanceFromAgentSquared{ FLT_MAX };
-	EntityInfo* pClosestItem = nullptr;
-	if (!foundPath)
-	{
-		if (m_pItemsOnGround->size() > 0)
-		{
-			for (EntityInfo& i : *m_pItemsOnGround)
-			{
-				// Check if the item is located inside of a purge zone
-				SpottedPurgeZone sp;
-				bool isInPurgeZone{ utils::IsLocationInsideGivenPurgezones(i.Location, m_PurgesZonesInSight,sp) };
-
-				// Only go for an item if it's not inside of the purgezone
-				if (!isInPurgeZone)
-				{
-					float distanceToAgentSquared = agentPos.DistanceSquared(i.Location);
-					if (distanceToAgentSquared < closestItemDistanceFromAgentSquared)
-					{
-						closestItemDistanceFromAgentSquared = distanceToAgentSquared;
-						pClosestItem = &i;
-					}
-				}
-			}
-
-			// Check if we found a nearby item and set the destination
-			if (pClosestItem)
-			{
-				DebugOutputManager::GetInstance()->DebugLine("closest item found\n",
-					DebugOutputManager::DebugType::GOAP_ACTION);
-				m_pAgent->SetDistantGoalPosition(pClosestItem->Location);
-				destination = pInterface->NavMesh_GetClosestPathPoint(pClosestItem->Location);
-			}
-			else
-				DebugOutputManager::GetInstance()->DebugLine("Error finding path to house\n",
-					DebugOutputManager::DebugType::PROBLEM);
-		}
-	}
-
-	// Find path to house
-	float closestHouseDistanceFromAgentSquared{ FLT_MAX };
-	ExploredHouse* pClosestHouse = nullptr;
-	if (!foundPath)
-	{
-		std::vector<ExploredHouse*> possibleHouses{};
-		for (ExploredHouse& h : *m_pHouseLocations)
-		{
-			// Check if the house is located inside of a purge zone
-			SpottedPurgeZone sp;
-			bool isInPurgeZone{ utils::IsLocationInsideGivenPurgezones(h.houseInfo.Center, m_PurgesZonesInSight,sp) };
-
-			// Only make the house available if it's not withing a purgezone
-			if (!isInPurgeZone)
-			{
-				if (h.itemsLootedSinceExplored > m_ItemsToLootBeforeHouseRevisit)
-					possibleHouses.push_back(&h);
-			}
-		}
-
-		if (possibleHouses.size() > 0)
-		{
-			for (ExploredHouse* h : possibleHouses)
-			{
-				float distanceToAgentSquared = agentPos.DistanceSquared(h->houseInfo.Center);
-				if (distanceToAgentSquared < closestHouseDistanceFromAgentSquared)
-				{
-					closestHouseDistanceFromAgentSquared = distanceToAgentSquared;
-					pClosestHouse = h;
-				}
-			}
-
-			if (pClosestHouse)
-			{
-				m_HouseGoalPos = pClosestHouse->houseInfo.Center;
-				m_pAgent->SetDistantGoalPosition(m_HouseGoalPos);
-				destination = pInterface->NavMesh_GetClosestPathPoint(m_HouseGoalPos);
-			}
-			else
-				DebugOutputManager::GetInstance()->DebugLine("Error finding path to house\n",
-					DebugOutputManager::DebugType::PROBLEM);
-		}
-	}
+	const Elite::Vector2& agentPos = m_pInterfaceCache->Agent_GetInfo().Position;
+	uint32_t itemTypeMask = GetItemTypeMask();
 
-	if (pClosestItem)
+	// Keep following the loot tour while only its own items were looted
+	RememberedItem stop{};
+	if (m_pLootTourPlanner->ContinueRoute(*m_pWorldMemory, itemTypeMask, stop))
 	{
-		if (closestItemDistanceFromAgentSquared < closestHouseDistanceFromAgentSquared)
-		{
-			m_pAgent->SetDistantGoalPosition(pClosestItem->Location);
-			destination = pInterface->NavMesh_GetClosestPathPoint(pClosestItem->Location);
-			DebugOutputManager::GetInstance()->DebugLine("Closest item found and its closer than the house\n",
-				DebugOutputManager::DebugType::GOAP_ACTION);
-		}
-		foundPath = true;
-	}
-	else if (pClosestHouse)
-	{
-		SpottedPurgeZone pz;
-		if (!utils::IsLocationInsideGivenPurgezones(pClosestHouse->houseInfo.Center, m_PurgesZonesInSight, pz))
-		{
-			m_pAgent->SetDistantGoalPosition(pClosestHouse->houseInfo.Center);
-			DebugOutputManager::GetInstance()->DebugLine("ClosestHouse chosen\n",
-				DebugOutputManager::DebugType::GOAP_ACTION);
-			foundPath = true;
-		}
+		m_pAgent->SetDistantGoalPosition(stop.entity.Location);
+		m_pAgent->SetGoalPosition(m_pInterfaceCache->NavMesh_GetClosestPathPoint(stop.entity.Location));
+		return;
 	}
 
-	// Found path to a house corner
-	if (!foundPath)
+	// Items, houses worth a revisit and corners outside of purgezones, scored in one pass
+	// An item or house closer than the other wins, corners only when there is neither
+	const std::vector<SeekTarget>& targets = m_pSeekTargetScorer->Score(*m_pWorldMemory, agentPos,
+		ConfigManager::GetInstance()->GetSeekTargetCount(), itemTypeMask);
+	if (targets.empty())
 	{
-		float closestCornerDistanceFromAgentSquared{ FLT_MAX };
-		Elite::Vector2 closestCorner{};
-		if (m_pHouseCornerLocations->size() > 0)
-		{
-			for (const Elite::Vector2& cornerLoc : (*m_pHouseCornerLocations))
-			{
-				// Check if the house is located inside of a purge zone
-				SpottedPurgeZone sp;
-				bool isInPurgeZone{ utils::IsLocationInsideGivenPurgezones(cornerLoc, m_PurgesZonesInSight,sp) };
-
-				// Only make the corner available if it's not withing a purgezone
-				if (!isInPurgeZone)
-				{
-					float distanceToAgentSquared = agentPos.DistanceSquared(cornerLoc);
-
-					if (distanceToAgentSquared < closestCornerDistanceFromAgentSquared)
-					{
-						closestCornerDistanceFromAgentSquared = distanceToAgentSquared;
-						closestCorner = cornerLoc;
-
-						// Set this corner to the goal location
-						m_pAgent->SetDistantGoalPosition(closestCorner);
-						destination = pInterface->NavMesh_GetClosestPathPoint(closestCorner);
-						foundPath = true;
-					}
-				}
-			}
-		}
-		else
+		if (m_pWorldMemory->GetCornerCount() == 0 && m_pWorldMemory->GetHouseCount() > 0)
 		{
 			// No more corners to discover
 			// All explored houses are unavailable
 			DebugOutputManager::GetInstance()->DebugLine("No more corners\n",
 				DebugOutputManager::DebugType::GOAP_ACTION);
-			int randomhouse = Elite::randomInt(m_pHouseLocations->size());
-			ExploredHouse& randomHouse = m_pHouseLocations->at(randomhouse);
-			randomHouse.itemsLootedSinceExplored = 999;
+			int randomhouse = Elite::randomInt(static_cast<int>(m_pWorldMemory->GetHouseCount()));
+			m_pWorldMemory->MarkHouseForRevisit(randomhouse);
 		}
-	}
 
-	// Log error message
-	if (!foundPath)
+		// Log error message
 		DebugOutputManager::GetInstance()->DebugLine("No path found in GOAPSearchItem::ChooseSeekLocation!\n",
 			DebugOutputManager::DebugType::PROBLEM);
+		m_pAgent->SetGoalPosition(Elite::Vector2{});
+		return;
+	}
+
+	const SeekTarget& target = targets.front();
+	Elite::Vector2 targetLocation = target.location;
+	switch (target.type)
+	{
+	case SeekTargetType::ITEM:
+		DebugOutputManager::GetInstance()->DebugLine("closest item found\n",
+			DebugOutputManager::DebugType::GOAP_ACTION);
+		// Loot the items around it in one route, starting wherever the route starts
+		if (m_pLootTourPlanner->PlanRoute(*m_pWorldMemory, agentPos, itemTypeMask, stop))
+			targetLocation = stop.entity.Location;
+		break;
+	case SeekTargetType::HOUSE:
+		m_HouseGoalPos = target.location;
+		DebugOutputManager::GetInstance()->DebugLine("ClosestHouse chosen\n",
+			DebugOutputManager::DebugType::GOAP_ACTION);
+		break;
+	case SeekTargetType::CORNER:
+		break;
+	}
 
 	// Set agent destination
-	m_pAgent->SetGoalPosition(destination);
+	m_pAgent->SetDistantGoalPosition(targetLocation);
+	m_pAgent->SetGoalPosition(m_pInterfaceCache->NavMesh_GetClosestPathPoint(targetLocation));
 }
 bool GOAPSearchItem::CheckArrival(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
 {
-	const Elite::Vector2& agentPos = pInterface->Agent_GetInfo().Position;
+	const Elite::Vector2& agentPos = m_pInterfaceCache->Agent_GetInfo().Position;
 
 	if (agentPos.DistanceSquared(m_HouseGoalPos) < m_ArrivalRange * m_ArrivalRange)
 	{
 		// Is he in a house?
-		if (m_AgentHouse)
-			m_AgentHouse->itemsLootedSinceExplored = 0;
+		if (m_AgentHouse >= 0)
+			m_pWorldMemory->MarkHouseExplored(m_AgentHouse, m_ItemsToLootBeforeHouseRevisit);
 	}
 
 	// Has the agent arrived at it's location
@@ -694,36 +626,6 @@ bool GOAPSearchItem::CheckArrival(IExamInterface* pInterface, GOAPPlanner* pPlan
 
 	return false;
 }
-void GOAPSearchItem::RemoveExploredCornerLocations(HouseInfo& houseInfo)
-{
-	int found{ 0 };
-	int houseIndex{ 0 };
-	std::vector<int> indexesToRemove{};
-	// Remove the house corner location if it's in the explored house vicinity		
-	auto findIt = std::remove_if(m_pHouseCornerLocations->begin(), m_pHouseCornerLocations->end(), [houseInfo, &found, &houseIndex, &indexesToRemove](Elite::Vector2& pos)
-		{
-			float margin{ 5.f };
-			float halfWidth = houseInfo.Size.x / 2.f;
-			float halfHeight = houseInfo.Size.y / 2.f;
-
-			// Check if corner location is in the vicinity of a house
-			if ((pos.x - margin < houseInfo.Center.x + halfWidth) && (pos.x + margin > houseInfo.Center.x - halfWidth) &&
-				(pos.y - margin < houseInfo.Center.y + halfHeight) && (pos.y + margin > houseInfo.Center.y - halfHeight))
-			{
-				indexesToRemove.push_back(houseIndex);
-				++found;
-				++houseIndex;
-				return true;
-			}
-			++houseIndex;
-			return false;
-		}
-	);
-
-	if (findIt != m_pHouseCornerLocations->end())
-		m_pHouseCornerLocations->erase(findIt, m_pHouseCornerLocations->end());
-}
-
 // SearchForFood: public GOAPSearchItem
 // Preconditions: InitialHouseScoutDone(true) 
 // Effects: HasFood(true)
@@ -831,103 +733,149 @@ void GOAPFastHouseScout::Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner
 	DebugOutputManager::GetInstance()->DebugLine("Setting up GOAPFastHouseScout\n",
 		DebugOutputManager::DebugType::GOAP_ACTION);
 
-	bool dataValid = pBlackboard->GetData("HouseLocations", m_pHouseLocations) && pBlackboard->GetData("HouseCornerLocations", m_pHouseCornerLocations);
+	bool dataValid = pBlackboard->GetData(BlackboardKeys::WORLD_MEMORY, m_pWorldMemory)
+		&& pBlackboard->GetData(BlackboardKeys::INTERFACE_CACHE, m_pInterfaceCache);
 	if (!dataValid)
 	{
 		DebugOutputManager::GetInstance()->DebugLine("Error obtaining blackboard data in GOAPFastHouseScout::Setup\n",
 			DebugOutputManager::DebugType::PROBLEM);
+		// Nothing to scout with
+		m_ScoutFinished = true;
 		return;
 	}
 
-	pBlackboard->GetData("ScoutedVectors", m_pScoutedVectors);
+	pBlackboard->GetData(BlackboardKeys::SCOUTED_VECTORS, m_pScoutedVectors);
+	pBlackboard->GetData(BlackboardKeys::LEVEL_OF_DETAIL, m_pLevelOfDetail);
+
+	m_WorldInfo = m_pInterfaceCache->World_GetInfo();
 
-	m_WorldInfo = pInterface->World_GetInfo();
+	// Start a new scout around the current position
+	m_ScoutOrigin = m_pInterfaceCache->Agent_GetInfo().Position;
+	float probeScale = m_pLevelOfDetail ? m_pLevelOfDetail->GetScoutProbeScale() : 1.f;
+	m_PositionsPerCycle = std::max(static_cast<int>(m_PositionsToCheck * probeScale) / m_Cycles, 1);
+	m_AngleIncrement = 360.f / m_PositionsPerCycle;
+	m_Angle = 0.f;
+	m_Cycle = 0;
+	m_PositionsChecked = 0;
+	m_FoundCorners.clear();
+	m_ScoutFinished = false;
 }
 bool GOAPFastHouseScout::Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt)
 {
-	ExploredHouse* pHouse;
-	pBlackboard->GetData("AgentHouse", pHouse);
-	if (pHouse)
+	int agentHouse{ -1 };
+	pBlackboard->GetData(BlackboardKeys::AGENT_HOUSE, agentHouse);
+	// Entering a house ends the scout early, the corners found so far are still kept
+	if (agentHouse >= 0 && !m_ScoutFinished)
 	{
-		return true;
+		CommitFoundCorners();
+		m_ScoutFinished = true;
 	}
 
-	int cycle{ 0 };
-	int positionsChecked{ 0 };
-	int positionsPerCycle = m_PositionsToCheck / m_Cycles;
-	float angleIncrement = 360.f / positionsPerCycle;
-	float angle{ 0.f };
+	if (!m_ScoutFinished)
+		ProbeStep(ConfigManager::GetInstance()->GetScoutProbesPerFrame());
+
+	if (m_ScoutFinished)
+		pPlanner->RaiseEvent(FSMEvent::ACTION_DONE);
+	return true;
+}
+ActionTask GOAPFastHouseScout::Execute(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
+{
+	// Setup already started the scout
+	while (!m_ScoutFinished)
+	{
+		int agentHouse{ -1 };
+		pBlackboard->GetData(BlackboardKeys::AGENT_HOUSE, agentHouse);
+		if (agentHouse >= 0)
+		{
+			CommitFoundCorners();
+			m_ScoutFinished = true;
+			break;
+		}
 
-	int housesFound{ 0 };
+		if (!ProbeStep(ConfigManager::GetInstance()->GetScoutProbesPerFrame()))
+			co_await NextFrame{};
+	}
+	co_return true;
+}
+bool GOAPFastHouseScout::IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const
+{
+	if (!m_ScoutFinished)
+		return false;
 
-	const Elite::Vector2& agentPos = pInterface->Agent_GetInfo().Position;
+	ApplyEffects(pInterface, pPlanner, pBlackboard);
+	return true;
+}
+bool GOAPFastHouseScout::ProbeStep(int probeBudget)
+{
+	int probesLeft = probeBudget > 0 ? probeBudget : INT_MAX;
 
-	while (positionsChecked < positionsPerCycle)
+	while (m_PositionsChecked < m_PositionsPerCycle && probesLeft > 0)
 	{
 		// Find a point to explore
-		float distance = m_DistanceFromAgent + cycle * m_DistanceIncreasePerCycle;
-		Elite::Vector2 locationToExplore{ agentPos.x + cos(angle) * distance, agentPos.y + sin(angle) * distance };
+		float distance = m_DistanceFromAgent + m_Cycle * m_DistanceIncreasePerCycle;
+		Elite::Vector2 locationToExplore{ m_ScoutOrigin.x + cos(m_Angle) * distance, m_ScoutOrigin.y + sin(m_Angle) * distance };
 		// Make sure it's inside of the navmesh
 		if (utils::IsPointInRect(locationToExplore, m_WorldInfo.Center, m_WorldInfo.Dimensions))
 		{
-			Elite::Vector2 cornerLocation = pInterface->NavMesh_GetClosestPathPoint(locationToExplore);
+			// Only probes inside the world count towards the budget, the others don't reach the host
+			--probesLeft;
+			Elite::Vector2 cornerLocation = m_pInterfaceCache->NavMesh_GetClosestPathPoint(locationToExplore);
 
 			// For debugging
 			if (m_pScoutedVectors)
 			{
-				m_pScoutedVectors->push_back(Line{ agentPos, locationToExplore });
+				m_pScoutedVectors->push_back(Line{ m_ScoutOrigin, locationToExplore });
 			}
 
 			// The new position was far enough to assume there was an obstacle!
 			if (locationToExplore.Distance(cornerLocation) >= m_IgnoreLocationDistance)
-			{
-				bool houseFound{ false };
-				for (const ExploredHouse& h : *m_pHouseLocations)
-				{
-					if (utils::IsPointInRect(cornerLocation, h.houseInfo.Center, h.houseInfo.Size, -3.f))
-					{
-						houseFound = true;
-						break;
-					}
-				}
-
-				if (!houseFound)
-				{
-					++housesFound;
-
-					m_pHouseCornerLocations->push_back(cornerLocation);
-				}
-			}
+				m_FoundCorners.push_back(cornerLocation);
 		}
 
-		++positionsChecked;
+		++m_PositionsChecked;
 		// Check if we completed the cycle
-		if (positionsChecked == positionsPerCycle && cycle < m_Cycles - 1)
+		if (m_PositionsChecked == m_PositionsPerCycle && m_Cycle < m_Cycles - 1)
 		{
-			positionsChecked = 0;
-			angle = 0.f;
-			++cycle;
+			m_PositionsChecked = 0;
+			m_Angle = 0.f;
+			++m_Cycle;
 
 			// If the cycle has an uneven count
-			if (cycle % 2 != 0)
-				angle += m_OffcycleAngleOffset;
+			if (m_Cycle % 2 != 0)
+				m_Angle += m_OffcycleAngleOffset;
 		}
 
-		angle += angleIncrement;
+		m_Angle += m_AngleIncrement;
 	}
 
-	if (housesFound > 0)
-	{
-		DebugOutputManager::GetInstance()->DebugLine("Found " + std::to_string(housesFound) + " unexplored houses!\n",
-			DebugOutputManager::DebugType::GOAP_ACTION);
-	}
+	if (m_PositionsChecked < m_PositionsPerCycle)
+		return false;
 
+	CommitFoundCorners();
+	m_ScoutFinished = true;
 	return true;
 }
-bool GOAPFastHouseScout::IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const
+void GOAPFastHouseScout::CommitFoundCorners()
 {
-	ApplyEffects(pInterface, pPlanner, pBlackboard);
-	return true;
+	// Skip corners of houses we already know, tested in one batch against the houses known by now
+	m_pWorldMemory->FindHousesContaining(m_FoundCorners, -3.f, m_FoundCornerHouses);
+
+	int unexploredCount{ 0 };
+	for (size_t i{ 0 }; i < m_FoundCorners.size(); ++i)
+	{
+		if (m_FoundCornerHouses[i] >= 0)
+			continue;
+
+		m_pWorldMemory->AddCorner(m_FoundCorners[i]);
+		++unexploredCount;
+	}
+
+	if (unexploredCount > 0)
+	{
+		DebugOutputManager::GetInstance()->DebugLine("Found " + std::to_string(unexploredCount) + " unexplored houses!\n",
+			DebugOutputManager::DebugType::GOAP_ACTION);
+	}
+	m_FoundCorners.clear();
 }
 void GOAPFastHouseScout::InitPreConditions(GOAPPlanner* pPlanner)
 {
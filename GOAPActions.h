@@ -3,6 +3,9 @@
 #include "SteeringHelpers.h"
 #include "IExamInterface.h"
 #include "structs.h"
+#include "BlackboardKeys.h"
+#include "ActionTask.h"
+#include "ItemMemory.h"
 #include <unordered_map>
 
 class Agent;
@@ -10,6 +13,13 @@ class Blackboard;
 class GOAPPlanner;
 class IExamInterface;
 class WorldState;
+class TickScheduler;
+class AILevelOfDetail;
+class PerceptionSnapshot;
+class CachedExamInterface;
+class WorldMemory;
+class SeekTargetScorer;
+class LootTourPlanner;
 
 class GOAPAction
 {
@@ -21,8 +31,11 @@ public:
 	virtual bool Plan(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) { return true; };
 	// Prepare the action
 	virtual void Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) {};
-	// Perform the action
-	virtual bool Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt) { return true; };
+	// Perform the action, raises FSMEvent::ACTION_DONE on the planner once IsDone can return true
+	virtual bool Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt);
+	// Coroutine alternative to Setup/Perform, started once when the action gets performed and ticked every frame after
+	virtual bool IsCoroutine() const { return false; };
+	virtual ActionTask Execute(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) { return ActionTask{}; };
 
 	std::vector<GOAPProperty*> GetPreconditions() { return m_Preconditions; };
 	std::vector<GOAPProperty*> GetEffects() { return m_Effects; };
@@ -31,10 +44,13 @@ public:
 	float GetCost()const { return m_Cost; };
 	virtual Elite::Vector2 GetMoveLocation() { return moveTarget.Position; };
 
-	virtual bool RequiresMovement(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const { return false; }; // If yes, the GoTo state will be ran before going into Perform
+	virtual bool RequiresMovement(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const { return false; }; // If yes, the GoTo state will be ran before going into Perform, raise FSMEvent::MOVEMENT_REQUIRED when this changes while performing
 	virtual bool IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const { return true; };
+	// Finishes within a single Perform without movement, lets the planner chain it in the same frame
+	virtual bool IsInstantaneous() const { return false; };
 
 	virtual std::string ToString() { return m_EffectName; };
+	const std::string& GetName() const { return m_EffectName; };
 protected:
 	std::string m_EffectName{ "Undefined effect" };
 	WorldState* m_pWorldState = nullptr;
@@ -77,7 +93,10 @@ public:
 	GOAPConsumeFood(GOAPPlanner* pPlanner);
 	virtual void Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard);
 	virtual bool Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt);
+	virtual bool IsCoroutine() const { return true; };
+	virtual ActionTask Execute(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard);
 	virtual bool IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const;
+	virtual bool IsInstantaneous() const { return true; };
 private:
 	virtual void InitPreConditions(GOAPPlanner* pPlanner);
 	virtual void InitEffects(GOAPPlanner* pPlanner);
@@ -92,7 +111,10 @@ public:
 	GOAPConsumeMedkit(GOAPPlanner* pPlanner);
 	virtual void Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard);
 	virtual bool Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt);
+	virtual bool IsCoroutine() const { return true; };
+	virtual ActionTask Execute(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard);
 	virtual bool IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const;
+	virtual bool IsInstantaneous() const { return true; };
 private:
 	virtual void InitPreConditions(GOAPPlanner* pPlanner);
 	virtual void InitEffects(GOAPPlanner* pPlanner);
@@ -111,23 +133,35 @@ public:
 	virtual bool RequiresMovement(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const { return false; };
 	virtual bool IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const;
 protected:
-	std::vector<Elite::Vector2>* m_pHouseCornerLocations = nullptr;
-	std::vector<ExploredHouse>* m_pHouseLocations = nullptr;
-	std::list<EntityInfo>* m_pItemsOnGround = nullptr;
+	WorldMemory* m_pWorldMemory = nullptr;
+	SeekTargetScorer* m_pSeekTargetScorer = nullptr; // Shared by every search, reuses the scores while nothing changed
+	LootTourPlanner* m_pLootTourPlanner = nullptr;
 	Agent* m_pAgent = nullptr;
+
+	// Item types the search goes after, the other remembered items are ignored
+	virtual uint32_t GetItemTypeMask() const { return ItemMemory::AllTypes; };
 private:
 	Elite::Vector2 m_selectedLocation{};
 	float m_ArrivalRange = 3.5f;
 	int m_ItemsToLootBeforeHouseRevisit = 28;
 	Elite::Vector2 m_HouseGoalPos{};
-	std::vector<SpottedPurgeZone> m_PurgesZonesInSight{};
+	float m_PurgeZoneMemoryTime = 3.f; // Seconds a spotted purgezone is avoided
+	float m_CornerRemovalMargin = 5.f; // Corners this close to a newly found house are forgotten
+
+	// Reused query output
+	std::vector<ItemHandle> m_ItemsInRange{};
+	std::vector<ItemHandle> m_GrabbedItems{};
 
 	Elite::Vector2 m_ItemLootedPosition{};
 
-	float m_ChooseSeekLocationTimer{};
-	float m_ChooseSeekLocationTime{ .25f };
+	TickScheduler* m_pTickScheduler = nullptr;
+	AILevelOfDetail* m_pLevelOfDetail = nullptr;
+	int m_PurgeZoneCheckFrame{ 0 }; // Purge zones are only scanned every few performs at lower detail
+	const PerceptionSnapshot* m_pPerception = nullptr;
+	CachedExamInterface* m_pInterfaceCache = nullptr;
 
-	ExploredHouse* m_AgentHouse = nullptr;
+	int m_AgentHouse{ -1 };
+	BlackboardSubscription<int> m_AgentHouseSubscription{ BlackboardKeys::AGENT_HOUSE };
 
 	// testing
 	float m_IsDoneTime = 4.f;
@@ -137,7 +171,6 @@ private:
 	virtual void InitEffects(GOAPPlanner* pPlanner);
 	void ChooseSeekLocation(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard);
 	bool CheckArrival(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard);
-	void RemoveExploredCornerLocations(HouseInfo& houseInfo);
 };
 
 class GOAPSearchForFood final : public GOAPSearchItem
@@ -148,6 +181,8 @@ public:
 	virtual bool Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt);
 	virtual bool RequiresMovement(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const { return false; };
 	virtual bool IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const;
+protected:
+	virtual uint32_t GetItemTypeMask() const override { return ItemMemory::GetTypeMask(eItemType::FOOD); };
 private:
 	virtual void InitPreConditions(GOAPPlanner* pPlanner);
 	virtual void InitEffects(GOAPPlanner* pPlanner);
@@ -161,6 +196,8 @@ public:
 	virtual bool Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt);
 	virtual bool RequiresMovement(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const { return false; };
 	virtual bool IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const;
+protected:
+	virtual uint32_t GetItemTypeMask() const override { return ItemMemory::GetTypeMask(eItemType::MEDKIT); };
 private:
 	virtual void InitPreConditions(GOAPPlanner* pPlanner);
 	virtual void InitEffects(GOAPPlanner* pPlanner);
@@ -172,15 +209,34 @@ public:
 	GOAPFastHouseScout(GOAPPlanner* pPlanner);
 	virtual void Setup(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) override;
 	virtual bool Perform(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float dt) override;
+	// The probes are spread over several frames, a budget per frame from the ConfigManager
+	virtual bool IsCoroutine() const { return true; };
+	virtual ActionTask Execute(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) override;
 	virtual bool IsDone(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const override;
 private:
 	virtual void InitPreConditions(GOAPPlanner* pPlanner) override;
 	virtual void InitEffects(GOAPPlanner* pPlanner) override;
 
-	std::vector<ExploredHouse>* m_pHouseLocations = nullptr;
-	std::vector<Elite::Vector2>* m_pHouseCornerLocations = nullptr;
-	int m_PositionsToCheck{ 36 };
+	// Probes up to the budget, returns true once every probe was done and the found corners are committed
+	bool ProbeStep(int probeBudget);
+	void CommitFoundCorners();
+
+	// Scout progress, kept across frames
+	Elite::Vector2 m_ScoutOrigin{};
+	int m_Cycle{ 0 };
+	int m_PositionsChecked{ 0 };
+	int m_PositionsPerCycle{ 1 };
+	float m_AngleIncrement{ 0.f };
+	float m_Angle{ 0.f };
+	bool m_ScoutFinished{ false };
+	std::vector<Elite::Vector2> m_FoundCorners{}; // Committed to the house corner locations when the scout finishes
+	std::vector<int> m_FoundCornerHouses{}; // House every found corner is in, reused between scouts
+
+	WorldMemory* m_pWorldMemory = nullptr;
+	int m_PositionsToCheck{ 36 }; // At full detail, scaled down by the level of detail
 	int m_Cycles{ 3 };
+	AILevelOfDetail* m_pLevelOfDetail = nullptr;
+	CachedExamInterface* m_pInterfaceCache = nullptr;
 	float m_OffcycleAngleOffset{ 5.f };
 	float m_DistanceFromAgent{ 25.f };
 	float m_DistanceIncreasePerCycle{ 45.f };
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "GOAPPlanner.h"
 #include "WorldState.h"
+#include "WorldStateHistory.h"
 #include "ActionSearchAlgorithm.h"
 #include "Blackboard.h"
 
@@ -29,6 +30,13 @@ bool GOAPPlanner::PlanAction()
 
 	m_pActionQueue = m_pSearchAlgorithm->Search(m_pGoalAction, m_pActions);
 
+	// Lets offline replay correlate replanning with the worldstate changes before it
+	if (m_pWorldState->GetHistory())
+		m_pWorldState->GetHistory()->RecordPlannerCall(m_pActionQueue.size());
+
+	if (m_pActionQueue.size() > 0)
+		RaiseEvent(FSMEvent::ACTION_CHANGED);
+
 	return m_pActionQueue.size() > 0;
 }
 
@@ -44,7 +52,42 @@ GOAPAction* GOAPPlanner::GetAction() const
 
 void GOAPPlanner::NextAction()
 {
+	if (m_pActionQueue.empty())
+		return;
+
 	m_pActionQueue.pop();
+	RaiseEvent(FSMEvent::ACTION_CHANGED);
+}
+
+int GOAPPlanner::PerformInstantActions(IExamInterface* pInterface, Blackboard* pBlackboard, int budget)
+{
+	int performedActions{ 0 };
+	GOAPAction* pAction = GetAction();
+	while (pAction && performedActions < budget && pAction->IsInstantaneous())
+	{
+		// Same steps the FSM takes, without the Idle -> Perform -> Idle round trip
+		if (pAction->RequiresMovement(pInterface, this, pBlackboard))
+			break;
+
+		pAction->Setup(pInterface, this, pBlackboard);
+		if (!pAction->Perform(pInterface, this, pBlackboard, 0.f))
+		{
+			SetEncounteredProblem(true);
+			break;
+		}
+
+		// Leave unfinished actions to the FSM
+		if (!pAction->IsDone(pInterface, this, pBlackboard))
+			break;
+
+		DebugOutputManager::GetInstance()->DebugLine("Performed instant action: " + pAction->ToString() + "\n",
+			DebugOutputManager::DebugType::GOAP_PLANNER);
+
+		++performedActions;
+		NextAction();
+		pAction = GetAction();
+	}
+	return performedActions;
 }
 
 WorldState* GOAPPlanner::GetWorldState()
@@ -68,9 +111,18 @@ void GOAPPlanner::AddActions(std::vector<GOAPAction*>& m_pActionsToAdd)
 void GOAPPlanner::SetEncounteredProblem(bool value)
 {
 	m_EncounteredProblem = value;
+	if (value)
+		RaiseEvent(FSMEvent::PROBLEM_ENCOUNTERED);
 }
 
 bool GOAPPlanner::GetEncounteredProblem() const
 {
 	return m_EncounteredProblem;
 }
+
+FSMEventMask GOAPPlanner::ConsumeEvents()
+{
+	FSMEventMask events = m_PendingEvents;
+	m_PendingEvents = FSMEvent::NONE;
+	return events;
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "GOAPActions.h"
+#include "FSMEvents.h"
 #include <vector>
 
 class ActionSearchAlgorithm;
@@ -14,6 +15,9 @@ public:
 	bool PlanAction();
 	GOAPAction* GetAction() const;
 	void NextAction();
+	// Performs instantaneous actions at the front of the queue until a regular action is next or the budget is spent
+	// Returns the amount of completed actions, a failing action sets EncounteredProblem
+	int PerformInstantActions(IExamInterface* pInterface, Blackboard* pBlackboard, int budget);
 
 	WorldState* GetWorldState();
 
@@ -22,6 +26,13 @@ public:
 
 	void SetEncounteredProblem(bool value);
 	bool GetEncounteredProblem() const;
+
+	// Events for an event driven FSM, they stay pending until consumed
+	void RaiseEvent(FSMEventMask events) { m_PendingEvents |= events; };
+	FSMEventMask ConsumeEvents();
+	// Set along with the FSM, states only raise the events they'd otherwise have to check every frame when it's set
+	void SetEventDriven(bool eventDriven) { m_EventDriven = eventDriven; };
+	bool IsEventDriven() const { return m_EventDriven; };
 private:
 	std::vector<GOAPAction*> m_pActions{};
 	std::queue<GOAPAction*> m_pActionQueue{};
@@ -32,4 +43,6 @@ private:
 	ActionSearchAlgorithm* m_pSearchAlgorithm = nullptr;
 
 	bool m_EncounteredProblem = false;
+	FSMEventMask m_PendingEvents = FSMEvent::NONE;
+	bool m_EventDriven = false;
 };
\ No newline at end of file
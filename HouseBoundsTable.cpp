@@ -0,0 +1,174 @@
+#include "stdafx.h"
+#include "HouseBoundsTable.h"
+#include <bit>
+#include <cfloat>
+#include <emmintrin.h>
+
+void HouseBoundsTable::Set(uint32_t index, const Elite::Vector2& center, const Elite::Vector2& size)
+{
+	if (index >= m_Count)
+	{
+		m_Count = index + 1;
+		size_t paddedCount = (m_Count + LaneCount - 1) / LaneCount * LaneCount;
+		m_MinX.resize(paddedCount, FLT_MAX);
+		m_MinY.resize(paddedCount, FLT_MAX);
+		m_MaxX.resize(paddedCount, -FLT_MAX);
+		m_MaxY.resize(paddedCount, -FLT_MAX);
+	}
+
+	// Same operations as utils::IsPointInRect
+	float halfWidth = size.x / 2.f;
+	float halfHeight = size.y / 2.f;
+	m_MinX[index] = center.x - halfWidth;
+	m_MinY[index] = center.y - halfHeight;
+	m_MaxX[index] = center.x + halfWidth;
+	m_MaxY[index] = center.y + halfHeight;
+}
+
+void HouseBoundsTable::Clear()
+{
+	m_MinX.clear();
+	m_MinY.clear();
+	m_MaxX.clear();
+	m_MaxY.clear();
+	m_Count = 0;
+}
+
+size_t HouseBoundsTable::GetMemoryFootprint() const
+{
+	return (m_MinX.capacity() + m_MinY.capacity() + m_MaxX.capacity() + m_MaxY.capacity()) * sizeof(float);
+}
+
+int HouseBoundsTable::FindContaining(const Elite::Vector2& point, float margin, int hint) const
+{
+	// The agent stays in the same house for many frames
+	if (hint >= 0 && static_cast<size_t>(hint) < m_Count && Contains(hint, point, margin))
+		return hint;
+
+	const __m128 lowX = _mm_set1_ps(point.x - margin);
+	const __m128 highX = _mm_set1_ps(point.x + margin);
+	const __m128 lowY = _mm_set1_ps(point.y - margin);
+	const __m128 highY = _mm_set1_ps(point.y + margin);
+	for (size_t i{ 0 }; i < m_Count; i += LaneCount)
+	{
+		__m128 insideX = _mm_and_ps(_mm_cmplt_ps(highX, _mm_loadu_ps(&m_MaxX[i])), _mm_cmpgt_ps(lowX, _mm_loadu_ps(&m_MinX[i])));
+		__m128 insideY = _mm_and_ps(_mm_cmplt_ps(highY, _mm_loadu_ps(&m_MaxY[i])), _mm_cmpgt_ps(lowY, _mm_loadu_ps(&m_MinY[i])));
+		int mask = _mm_movemask_ps(_mm_and_ps(insideX, insideY));
+		if (mask != 0)
+			return static_cast<int>(i) + std::countr_zero(static_cast<unsigned int>(mask));
+	}
+	return -1;
+}
+
+void HouseBoundsTable::FindContaining(const std::vector<Elite::Vector2>& points, float margin, std::vector<int>& houses) const
+{
+	houses.assign(points.size(), -1);
+	if (m_Count == 0)
+		return;
+
+	// Four points per pass over the houses, the pass ends once all four found a house
+	for (size_t first{ 0 }; first < points.size(); first += LaneCount)
+	{
+		size_t laneCount = std::min(LaneCount, points.size() - first);
+		alignas(16) float x[LaneCount];
+		alignas(16) float y[LaneCount];
+		for (size_t lane{ 0 }; lane < LaneCount; ++lane)
+		{
+			// Unused lanes repeat the last point
+			const Elite::Vector2& point = points[first + std::min(lane, laneCount - 1)];
+			x[lane] = point.x;
+			y[lane] = point.y;
+		}
+
+		const __m128 marginLanes = _mm_set1_ps(margin);
+		const __m128 lowX = _mm_sub_ps(_mm_load_ps(x), marginLanes);
+		const __m128 highX = _mm_add_ps(_mm_load_ps(x), marginLanes);
+		const __m128 lowY = _mm_sub_ps(_mm_load_ps(y), marginLanes);
+		const __m128 highY = _mm_add_ps(_mm_load_ps(y), marginLanes);
+
+		__m128i result = _mm_set1_epi32(-1);
+		__m128 found = _mm_setzero_ps();
+		for (size_t house{ 0 }; house < m_Count; ++house)
+		{
+			__m128 insideX = _mm_and_ps(_mm_cmplt_ps(highX, _mm_set1_ps(m_MaxX[house])), _mm_cmpgt_ps(lowX, _mm_set1_ps(m_MinX[house])));
+			__m128 insideY = _mm_and_ps(_mm_cmplt_ps(highY, _mm_set1_ps(m_MaxY[house])), _mm_cmpgt_ps(lowY, _mm_set1_ps(m_MinY[house])));
+			__m128 inside = _mm_and_ps(insideX, insideY);
+
+			// Only the first house a point is in counts
+			__m128i newHits = _mm_castps_si128(_mm_andnot_ps(found, inside));
+			result = _mm_or_si128(_mm_and_si128(newHits, _mm_set1_epi32(static_cast<int>(house))), _mm_andnot_si128(newHits, result));
+			found = _mm_or_ps(found, inside);
+			if (_mm_movemask_ps(found) == 0xF)
+				break;
+		}
+
+		alignas(16) int lanes[LaneCount];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), result);
+		for (size_t lane{ 0 }; lane < laneCount; ++lane)
+		{
+			houses[first + lane] = lanes[lane];
+		}
+	}
+}
+
+int HouseBoundsTable::FindContainingScalar(const Elite::Vector2& point, float margin) const
+{
+	for (size_t i{ 0 }; i < m_Count; ++i)
+	{
+		if (Contains(i, point, margin))
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+
+void HouseBoundsTable::FindPointsInHouse(const std::vector<QuantizedPosition>& points, const PositionQuantizer& quantizer,
+	const Elite::Vector2& center, const Elite::Vector2& size, float margin, std::vector<uint32_t>& indices)
+{
+	float halfWidth = size.x / 2.f;
+	float halfHeight = size.y / 2.f;
+	const __m128 minX = _mm_set1_ps(center.x - halfWidth);
+	const __m128 minY = _mm_set1_ps(center.y - halfHeight);
+	const __m128 maxX = _mm_set1_ps(center.x + halfWidth);
+	const __m128 maxY = _mm_set1_ps(center.y + halfHeight);
+	const __m128 marginLanes = _mm_set1_ps(margin);
+	const __m128 step = _mm_set1_ps(quantizer.GetStep());
+	const __m128 quantizerMinX = _mm_set1_ps(quantizer.GetMin().x);
+	const __m128 quantizerMinY = _mm_set1_ps(quantizer.GetMin().y);
+	const __m128i lowHalf = _mm_set1_epi32(0xFFFF);
+
+	// Four quantized points fill a register, x in the low and y in the high half of every lane
+	static_assert(sizeof(QuantizedPosition) == sizeof(uint32_t), "Quantized positions have to be packed");
+	size_t i{ 0 };
+	for (; i + LaneCount <= points.size(); i += LaneCount)
+	{
+		__m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&points[i]));
+		// Decoded like PositionQuantizer::Decode
+		__m128 x = _mm_add_ps(quantizerMinX, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, lowHalf)), step));
+		__m128 y = _mm_add_ps(quantizerMinY, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(packed, 16)), step));
+
+		__m128 insideX = _mm_and_ps(_mm_cmplt_ps(_mm_add_ps(x, marginLanes), maxX), _mm_cmpgt_ps(_mm_sub_ps(x, marginLanes), minX));
+		__m128 insideY = _mm_and_ps(_mm_cmplt_ps(_mm_add_ps(y, marginLanes), maxY), _mm_cmpgt_ps(_mm_sub_ps(y, marginLanes), minY));
+		unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(_mm_and_ps(insideX, insideY)));
+		while (mask != 0)
+		{
+			indices.push_back(static_cast<uint32_t>(i) + std::countr_zero(mask));
+			mask &= mask - 1;
+		}
+	}
+
+	for (; i < points.size(); ++i)
+	{
+		Elite::Vector2 point = quantizer.Decode(points[i]);
+		if (point.x + margin < center.x + halfWidth && point.x - margin > center.x - halfWidth &&
+			point.y + margin < center.y + halfHeight && point.y - margin > center.y - halfHeight)
+		{
+			indices.push_back(static_cast<uint32_t>(i));
+		}
+	}
+}
+
+bool HouseBoundsTable::Contains(size_t index, const Elite::Vector2& point, float margin) const
+{
+	return point.x + margin < m_MaxX[index] && point.x - margin > m_MinX[index]
+		&& point.y + margin < m_MaxY[index] && point.y - margin > m_MinY[index];
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "EliteMath/EMath.h"
+#include "PositionQuantizer.h"
+
+// Bounds of every known house as a structure of arrays, tested four houses or four points at a time with SSE
+// The tests give the same result as utils::IsPointInRect, the bounds are computed with the same float operations
+class HouseBoundsTable final
+{
+public:
+	static constexpr size_t LaneCount = 4;
+
+	// The index is the house's index in the WorldMemory, setting past the end grows the table
+	void Set(uint32_t index, const Elite::Vector2& center, const Elite::Vector2& size);
+	void Clear();
+	size_t GetCount() const { return m_Count; };
+	size_t GetMemoryFootprint() const;
+
+	// First house the point is in, -1 if it isn't in any. The margin works like utils::IsPointInRect
+	// The hint is tested before the others, pass the house the point was in last frame
+	int FindContaining(const Elite::Vector2& point, float margin, int hint = -1) const;
+	// First house every point is in, -1 for the points that aren't in any
+	void FindContaining(const std::vector<Elite::Vector2>& points, float margin, std::vector<int>& houses) const;
+	// Reference for the kernels, one house at a time
+	int FindContainingScalar(const Elite::Vector2& point, float margin) const;
+
+	// Appends the indices of the quantized points in the house in ascending order, the margin works like utils::IsPointInRect
+	static void FindPointsInHouse(const std::vector<QuantizedPosition>& points, const PositionQuantizer& quantizer,
+		const Elite::Vector2& center, const Elite::Vector2& size, float margin, std::vector<uint32_t>& indices);
+private:
+	// Padded to a multiple of the lane count with bounds nothing is in
+	std::vector<float> m_MinX{};
+	std::vector<float> m_MinY{};
+	std::vector<float> m_MaxX{};
+	std::vector<float> m_MaxY{};
+	size_t m_Count{ 0 };
+
+	bool Contains(size_t index, const Elite::Vector2& point, float margin) const;
+};
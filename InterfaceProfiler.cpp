@@ -0,0 +1,206 @@
+#include "stdafx.h"
+#include "InterfaceProfiler.h"
+#include <cstring>
+
+InterfaceProfiler* InterfaceProfiler::instance = 0;
+
+bool InterfaceProfiler::Open(const std::string& frameFilePath, const std::string& histogramFilePath)
+{
+	if (m_Enabled)
+		Close();
+
+	m_FrameFile.open(frameFilePath, std::ios::trunc);
+	if (!m_FrameFile)
+		return false;
+	m_FrameFile << "frame,scope,call,count,microseconds\n";
+	m_HistogramFilePath = histogramFilePath;
+
+	m_Scopes.clear();
+	m_ScopeStack.clear();
+	memset(m_FrameCalls, 0, sizeof(m_FrameCalls));
+	memset(m_LatencyHistogram, 0, sizeof(m_LatencyHistogram));
+	memset(m_FrameCallHistogram, 0, sizeof(m_FrameCallHistogram));
+	m_FrameStarted = false;
+
+	// Calls made outside of any scope
+	FindOrAddScope("Unattributed");
+
+	m_Enabled = true;
+	return true;
+}
+
+void InterfaceProfiler::Close()
+{
+	if (!m_Enabled)
+		return;
+
+	if (m_FrameStarted)
+		WriteFrame();
+	WriteHistograms();
+	m_FrameFile.close();
+	m_Enabled = false;
+}
+
+void InterfaceProfiler::BeginFrame(uint32_t frame)
+{
+	if (!m_Enabled)
+		return;
+
+	if (m_FrameStarted)
+		WriteFrame();
+	m_Frame = frame;
+	m_FrameStarted = true;
+}
+
+void InterfaceProfiler::PushScope(const char* scopeName)
+{
+	m_ScopeStack.push_back(FindOrAddScope(scopeName));
+}
+
+void InterfaceProfiler::PopScope()
+{
+	if (!m_ScopeStack.empty())
+		m_ScopeStack.pop_back();
+}
+
+void InterfaceProfiler::RecordCall(InterfaceCall call, float microseconds)
+{
+	int callIndex = static_cast<int>(call);
+	ScopeData& scope = m_Scopes[m_ScopeStack.empty() ? 0 : m_ScopeStack.back()];
+	++scope.frameStats[callIndex].count;
+	scope.frameStats[callIndex].microseconds += microseconds;
+
+	++m_FrameCalls[callIndex];
+	++m_LatencyHistogram[callIndex][GetBucket(static_cast<uint32_t>(microseconds), LatencyBucketCount)];
+}
+
+const char* InterfaceProfiler::GetCallName(InterfaceCall call)
+{
+	switch (call)
+	{
+	case InterfaceCall::AGENT_GET_INFO:
+		return "Agent_GetInfo";
+	case InterfaceCall::NAVMESH_GET_CLOSEST_PATH_POINT:
+		return "NavMesh_GetClosestPathPoint";
+	case InterfaceCall::FOV_GET_ENTITY_BY_INDEX:
+		return "Fov_GetEntityByIndex";
+	case InterfaceCall::FOV_GET_HOUSE_BY_INDEX:
+		return "Fov_GetHouseByIndex";
+	case InterfaceCall::INVENTORY_GET_CAPACITY:
+		return "Inventory_GetCapacity";
+	case InterfaceCall::INVENTORY_GET_ITEM:
+		return "Inventory_GetItem";
+	case InterfaceCall::INVENTORY_ADD_ITEM:
+		return "Inventory_AddItem";
+	case InterfaceCall::INVENTORY_USE_ITEM:
+		return "Inventory_UseItem";
+	case InterfaceCall::INVENTORY_REMOVE_ITEM:
+		return "Inventory_RemoveItem";
+	case InterfaceCall::ITEM_GRAB:
+		return "Item_Grab";
+	case InterfaceCall::ITEM_GET_INFO:
+		return "Item_GetInfo";
+	case InterfaceCall::ITEM_DESTROY:
+		return "Item_Destroy";
+	case InterfaceCall::WEAPON_GET_AMMO:
+		return "Weapon_GetAmmo";
+	case InterfaceCall::FOOD_GET_ENERGY:
+		return "Food_GetEnergy";
+	case InterfaceCall::MEDKIT_GET_HEALTH:
+		return "Medkit_GetHealth";
+	case InterfaceCall::PURGEZONE_GET_INFO:
+		return "PurgeZone_GetInfo";
+	case InterfaceCall::WORLD_GET_INFO:
+		return "World_GetInfo";
+	default:
+		return "Unknown";
+	}
+}
+
+int InterfaceProfiler::FindOrAddScope(const char* scopeName)
+{
+	// Only a handful of subsystems and actions, a linear search is fine
+	for (size_t i{ 0 }; i < m_Scopes.size(); ++i)
+	{
+		if (m_Scopes[i].name == scopeName)
+			return static_cast<int>(i);
+	}
+
+	m_Scopes.push_back(ScopeData{ scopeName });
+	return static_cast<int>(m_Scopes.size() - 1);
+}
+
+void InterfaceProfiler::WriteFrame()
+{
+	for (ScopeData& scope : m_Scopes)
+	{
+		for (int call{ 0 }; call < CallCount; ++call)
+		{
+			CallStats& stats = scope.frameStats[call];
+			if (stats.count == 0)
+				continue;
+
+			m_FrameFile << m_Frame << ',' << scope.name << ',' << GetCallName(static_cast<InterfaceCall>(call)) << ','
+				<< stats.count << ',' << stats.microseconds << '\n';
+
+			scope.sessionStats[call].count += stats.count;
+			scope.sessionStats[call].microseconds += stats.microseconds;
+			stats = CallStats{};
+		}
+	}
+
+	for (int call{ 0 }; call < CallCount; ++call)
+	{
+		++m_FrameCallHistogram[call][GetBucket(m_FrameCalls[call], FrameCallBucketCount)];
+		m_FrameCalls[call] = 0;
+	}
+}
+
+void InterfaceProfiler::WriteHistograms() const
+{
+	std::ofstream file{ m_HistogramFilePath, std::ios::trunc };
+	if (!file)
+		return;
+
+	file << "Session totals per scope\n";
+	for (const ScopeData& scope : m_Scopes)
+	{
+		for (int call{ 0 }; call < CallCount; ++call)
+		{
+			const CallStats& stats = scope.sessionStats[call];
+			if (stats.count > 0)
+				file << scope.name << ' ' << GetCallName(static_cast<InterfaceCall>(call)) << ": "
+				<< stats.count << " calls, " << stats.microseconds << " us\n";
+		}
+	}
+
+	// Bucket i holds values in [2^(i-1), 2^i), bucket 0 holds 0
+	file << "\nLatency histogram in us, buckets <1 <2 <4 ... >=" << (1u << (LatencyBucketCount - 2)) << '\n';
+	for (int call{ 0 }; call < CallCount; ++call)
+	{
+		file << GetCallName(static_cast<InterfaceCall>(call)) << ':';
+		for (uint32_t count : m_LatencyHistogram[call])
+			file << ' ' << count;
+		file << '\n';
+	}
+
+	file << "\nCalls per frame histogram, buckets 0 <2 <4 ... >=" << (1u << (FrameCallBucketCount - 2)) << '\n';
+	for (int call{ 0 }; call < CallCount; ++call)
+	{
+		file << GetCallName(static_cast<InterfaceCall>(call)) << ':';
+		for (uint32_t count : m_FrameCallHistogram[call])
+			file << ' ' << count;
+		file << '\n';
+	}
+}
+
+int InterfaceProfiler::GetBucket(uint32_t value, int bucketCount)
+{
+	int bucket{ 0 };
+	while (value > 0 && bucket < bucketCount - 1)
+	{
+		value >>= 1;
+		++bucket;
+	}
+	return bucket;
+}
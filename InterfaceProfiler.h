@@ -0,0 +1,150 @@
+#pragma once
+#include <cstdint>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Every host call of the IExamInterface the agent makes
+enum class InterfaceCall
+{
+	AGENT_GET_INFO,
+	NAVMESH_GET_CLOSEST_PATH_POINT,
+	FOV_GET_ENTITY_BY_INDEX,
+	FOV_GET_HOUSE_BY_INDEX,
+	INVENTORY_GET_CAPACITY,
+	INVENTORY_GET_ITEM,
+	INVENTORY_ADD_ITEM,
+	INVENTORY_USE_ITEM,
+	INVENTORY_REMOVE_ITEM,
+	ITEM_GRAB,
+	ITEM_GET_INFO,
+	ITEM_DESTROY,
+	WEAPON_GET_AMMO,
+	FOOD_GET_ENERGY,
+	MEDKIT_GET_HEALTH,
+	PURGEZONE_GET_INFO,
+	WORLD_GET_INFO,
+	COUNT
+};
+
+// Counts and times the interface calls per frame and attributes them to the innermost open scope
+// Writes one csv row per (scope, call) pair that was used in a frame, session histograms are written on Close
+class InterfaceProfiler final
+{
+public:
+	static InterfaceProfiler* GetInstance()
+	{
+		if (!instance)
+		{
+			instance = new InterfaceProfiler();
+		}
+		return instance;
+	}
+
+	// Starts profiling into the given files, returns false if a file could not be opened
+	bool Open(const std::string& frameFilePath, const std::string& histogramFilePath);
+	// Writes the last frame and the histograms
+	void Close();
+	bool IsEnabled() const { return m_Enabled; };
+
+	// Writes the summary of the previous frame
+	void BeginFrame(uint32_t frame);
+
+	// Scopes nest, calls go to the innermost one. Names are copied the first time they are seen
+	void PushScope(const char* scopeName);
+	void PopScope();
+
+	void RecordCall(InterfaceCall call, float microseconds);
+
+	static const char* GetCallName(InterfaceCall call);
+
+	static InterfaceProfiler* instance;
+private:
+	InterfaceProfiler() = default;
+
+	static const int CallCount = static_cast<int>(InterfaceCall::COUNT);
+	// Latency buckets double in size, the first bucket holds calls under 1 us and the last everything above
+	static const int LatencyBucketCount = 12;
+	// Calls per frame buckets double in size too, starting at 0 calls
+	static const int FrameCallBucketCount = 10;
+
+	struct CallStats
+	{
+		uint32_t count{ 0 };
+		float microseconds{ 0.f };
+	};
+
+	struct ScopeData
+	{
+		std::string name;
+		CallStats frameStats[CallCount]{};
+		CallStats sessionStats[CallCount]{};
+	};
+
+	bool m_Enabled{ false };
+	std::ofstream m_FrameFile{};
+	std::string m_HistogramFilePath{};
+	uint32_t m_Frame{ 0 };
+	bool m_FrameStarted{ false }; // No frame to write before the first BeginFrame
+
+	std::vector<ScopeData> m_Scopes{};
+	std::vector<int> m_ScopeStack{}; // Indices into m_Scopes, empty means unattributed
+
+	uint32_t m_FrameCalls[CallCount]{};
+	uint32_t m_LatencyHistogram[CallCount][LatencyBucketCount]{};
+	uint32_t m_FrameCallHistogram[CallCount][FrameCallBucketCount]{};
+
+	int FindOrAddScope(const char* scopeName);
+	void WriteFrame();
+	void WriteHistograms() const;
+	static int GetBucket(uint32_t value, int bucketCount);
+};
+
+// Attributes the interface calls made during its lifetime to a subsystem or action
+class InterfaceProfileScope final
+{
+public:
+	explicit InterfaceProfileScope(const char* scopeName) :
+		m_Active(InterfaceProfiler::GetInstance()->IsEnabled())
+	{
+		if (m_Active)
+			InterfaceProfiler::GetInstance()->PushScope(scopeName);
+	}
+	~InterfaceProfileScope()
+	{
+		if (m_Active)
+			InterfaceProfiler::GetInstance()->PopScope();
+	}
+	InterfaceProfileScope(const InterfaceProfileScope&) = delete;
+	InterfaceProfileScope& operator=(const InterfaceProfileScope&) = delete;
+private:
+	bool m_Active;
+};
+
+// Times a single host call, does nothing while the profiler is closed
+class ScopedInterfaceCall final
+{
+public:
+	explicit ScopedInterfaceCall(InterfaceCall call) :
+		m_Call(call),
+		m_Active(InterfaceProfiler::GetInstance()->IsEnabled())
+	{
+		if (m_Active)
+			m_Start = std::chrono::high_resolution_clock::now();
+	}
+	~ScopedInterfaceCall()
+	{
+		if (m_Active)
+		{
+			std::chrono::duration<float, std::micro> duration = std::chrono::high_resolution_clock::now() - m_Start;
+			InterfaceProfiler::GetInstance()->RecordCall(m_Call, duration.count());
+		}
+	}
+	ScopedInterfaceCall(const ScopedInterfaceCall&) = delete;
+	ScopedInterfaceCall& operator=(const ScopedInterfaceCall&) = delete;
+private:
+	InterfaceCall m_Call;
+	bool m_Active;
+	std::chrono::high_resolution_clock::time_point m_Start{};
+};
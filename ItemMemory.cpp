@@ -0,0 +1,284 @@
+#include "stdafx.h"
+#include "ItemMemory.h"
+
+ItemMemory::ItemMemory(float cellSize, const PositionQuantizer& quantizer) :
+	m_Quantizer(quantizer)
+{
+	m_Types.reserve(TypeCount);
+	for (size_t type{ 0 }; type < TypeCount; ++type)
+	{
+		m_Types.emplace_back(cellSize);
+	}
+}
+
+ItemHandle ItemMemory::Add(const EntityInfo& entity, eItemType type, float time)
+{
+	uint32_t typeIndex = static_cast<uint32_t>(type);
+	if (typeIndex >= TypeCount)
+		return ItemHandle{};
+
+	// Everything works on the decoded position, so the grid and the hash see what is stored
+	QuantizedPosition quantizedLocation = m_Quantizer.Encode(entity.Location);
+	Elite::Vector2 location = m_Quantizer.Decode(quantizedLocation);
+
+	uint32_t knownSlot = FindKnown(location);
+	if (knownSlot != UINT32_MAX)
+	{
+		m_Slots[knownSlot].lastSeen = time;
+		Unlink(knownSlot);
+		LinkMostRecent(knownSlot);
+		return ItemHandle{};
+	}
+
+	// Reuse a free slot if there is one
+	uint32_t slot = m_FirstFreeSlot;
+	if (slot != UINT32_MAX)
+		m_FirstFreeSlot = m_Slots[slot].typeAndIndex;
+	else
+	{
+		slot = static_cast<uint32_t>(m_Slots.size());
+		m_Slots.push_back(Slot{});
+	}
+
+	TypeStorage& storage = m_Types[typeIndex];
+	Slot& slotData = m_Slots[slot];
+	slotData.Set(typeIndex, static_cast<uint32_t>(storage.positions.size()));
+	slotData.lastSeen = time;
+	LinkMostRecent(slot);
+
+	storage.positions.push_back(quantizedLocation);
+	storage.entityHashes.push_back(entity.EntityHash);
+	storage.slots.push_back(slot);
+	storage.grid.Insert(slot, location);
+	m_PositionHash.emplace(GetPositionKey(Quantize(location.x), Quantize(location.y)), slot);
+	++m_Count;
+	++m_Revision;
+
+	return ItemHandle{ slot, slotData.generation };
+}
+
+bool ItemMemory::Remove(ItemHandle handle)
+{
+	RememberedItem item{};
+	if (!Get(handle, item))
+		return false;
+
+	Slot& slotData = m_Slots[handle.slot];
+	TypeStorage& storage = m_Types[slotData.GetType()];
+	uint32_t index = slotData.GetIndex();
+	const Elite::Vector2& location = item.entity.Location;
+
+	storage.grid.Remove(handle.slot, location);
+	RemoveFromPositionHash(location, handle.slot);
+	Unlink(handle.slot);
+
+	// Swap and pop, the moved item keeps its slot so only the slot's index changes
+	uint32_t lastIndex = static_cast<uint32_t>(storage.positions.size() - 1);
+	if (index != lastIndex)
+	{
+		storage.positions[index] = storage.positions[lastIndex];
+		storage.entityHashes[index] = storage.entityHashes[lastIndex];
+		storage.slots[index] = storage.slots[lastIndex];
+		m_Slots[storage.slots[index]].Set(slotData.GetType(), index);
+	}
+	storage.positions.pop_back();
+	storage.entityHashes.pop_back();
+	storage.slots.pop_back();
+
+	// Outdates every handle to this slot
+	++slotData.generation;
+	slotData.typeAndIndex = m_FirstFreeSlot;
+	m_FirstFreeSlot = handle.slot;
+	--m_Count;
+	++m_Revision;
+	return true;
+}
+
+void ItemMemory::Clear()
+{
+	for (TypeStorage& storage : m_Types)
+	{
+		storage.positions.clear();
+		storage.entityHashes.clear();
+		storage.slots.clear();
+		storage.grid.Clear();
+	}
+
+	// Keep the generations so old handles stay invalid
+	m_FirstFreeSlot = UINT32_MAX;
+	for (size_t i{ m_Slots.size() }; i > 0; --i)
+	{
+		Slot& slotData = m_Slots[i - 1];
+		++slotData.generation;
+		slotData.previous = slotData.next = UINT32_MAX;
+		slotData.typeAndIndex = m_FirstFreeSlot;
+		m_FirstFreeSlot = static_cast<uint32_t>(i - 1);
+	}
+
+	m_PositionHash.clear();
+	m_Count = 0;
+	++m_Revision;
+	m_MostRecentlySeen = m_LeastRecentlySeen = UINT32_MAX;
+}
+
+bool ItemMemory::Get(ItemHandle handle, RememberedItem& item) const
+{
+	if (handle.slot >= m_Slots.size())
+		return false;
+
+	// Removing an item moves its slot to the next generation
+	const Slot& slotData = m_Slots[handle.slot];
+	if (slotData.generation != handle.generation)
+		return false;
+
+	item = Decode(slotData);
+	return true;
+}
+
+float ItemMemory::GetLastSeen(ItemHandle handle) const
+{
+	if (handle.slot >= m_Slots.size() || m_Slots[handle.slot].generation != handle.generation)
+		return -FLT_MAX;
+	return m_Slots[handle.slot].lastSeen;
+}
+
+ItemHandle ItemMemory::FindEvictionCandidate(const Elite::Vector2& position, size_t window) const
+{
+	ItemHandle candidate{};
+	float furthestDistanceSq{ -1.f };
+	uint32_t slot = m_LeastRecentlySeen;
+	for (size_t i{ 0 }; i < window && slot != UINT32_MAX; ++i)
+	{
+		const Slot& slotData = m_Slots[slot];
+		float distanceSq = position.DistanceSquared(GetLocation(slotData));
+		if (distanceSq > furthestDistanceSq)
+		{
+			furthestDistanceSq = distanceSq;
+			candidate = ItemHandle{ slot, slotData.generation };
+		}
+		slot = slotData.previous;
+	}
+	return candidate;
+}
+
+size_t ItemMemory::GetMemoryFootprint() const
+{
+	size_t bytes = m_Slots.capacity() * sizeof(Slot);
+	for (const TypeStorage& storage : m_Types)
+	{
+		bytes += storage.positions.capacity() * sizeof(QuantizedPosition) + storage.entityHashes.capacity() * sizeof(int)
+			+ storage.slots.capacity() * sizeof(uint32_t);
+		bytes += storage.grid.GetMemoryFootprint();
+	}
+
+	// Every hash entry is a node with a next pointer, plus one pointer per bucket
+	bytes += m_PositionHash.size() * (sizeof(std::pair<const uint64_t, uint32_t>) + sizeof(void*))
+		+ m_PositionHash.bucket_count() * sizeof(void*);
+	return bytes;
+}
+
+void ItemMemory::Query(const Elite::Vector2& center, float radius, std::vector<ItemHandle>& handles, uint32_t typeMask) const
+{
+	for (size_t type{ 0 }; type < TypeCount; ++type)
+	{
+		const TypeStorage& storage = m_Types[type];
+		if ((typeMask & (1u << type)) == 0 || storage.positions.empty())
+			continue;
+
+		m_QueryResult.clear();
+		storage.grid.QueryRadius(center, radius, m_QueryResult);
+		for (uint32_t slot : m_QueryResult)
+		{
+			handles.push_back(ItemHandle{ slot, m_Slots[slot].generation });
+		}
+	}
+}
+
+uint64_t ItemMemory::GetPositionKey(int cellX, int cellY)
+{
+	return static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32 | static_cast<uint32_t>(cellY);
+}
+
+int ItemMemory::Quantize(float coordinate)
+{
+	return static_cast<int>(floorf(coordinate / DedupeDistance));
+}
+
+Elite::Vector2 ItemMemory::GetLocation(const Slot& slotData) const
+{
+	return m_Quantizer.Decode(m_Types[slotData.GetType()].positions[slotData.GetIndex()]);
+}
+
+RememberedItem ItemMemory::Decode(const Slot& slotData) const
+{
+	const TypeStorage& storage = m_Types[slotData.GetType()];
+	uint32_t index = slotData.GetIndex();
+
+	RememberedItem item{};
+	item.entity.Type = eEntityType::ITEM;
+	item.entity.Location = m_Quantizer.Decode(storage.positions[index]);
+	item.entity.EntityHash = storage.entityHashes[index];
+	item.type = static_cast<eItemType>(slotData.GetType());
+	return item;
+}
+
+uint32_t ItemMemory::FindKnown(const Elite::Vector2& location) const
+{
+	// Anything closer than the dedupe distance is in the same or a neighbouring cell
+	int cellX = Quantize(location.x);
+	int cellY = Quantize(location.y);
+	for (int y{ cellY - 1 }; y <= cellY + 1; ++y)
+	{
+		for (int x{ cellX - 1 }; x <= cellX + 1; ++x)
+		{
+			auto range = m_PositionHash.equal_range(GetPositionKey(x, y));
+			for (auto it = range.first; it != range.second; ++it)
+			{
+				if (GetLocation(m_Slots[it->second]).DistanceSquared(location) < DedupeDistance * DedupeDistance)
+					return it->second;
+			}
+		}
+	}
+	return UINT32_MAX;
+}
+
+void ItemMemory::RemoveFromPositionHash(const Elite::Vector2& location, uint32_t slot)
+{
+	auto range = m_PositionHash.equal_range(GetPositionKey(Quantize(location.x), Quantize(location.y)));
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second == slot)
+		{
+			m_PositionHash.erase(it);
+			return;
+		}
+	}
+}
+
+void ItemMemory::LinkMostRecent(uint32_t slot)
+{
+	Slot& slotData = m_Slots[slot];
+	slotData.previous = UINT32_MAX;
+	slotData.next = m_MostRecentlySeen;
+	if (m_MostRecentlySeen != UINT32_MAX)
+		m_Slots[m_MostRecentlySeen].previous = slot;
+	else
+		m_LeastRecentlySeen = slot;
+	m_MostRecentlySeen = slot;
+}
+
+void ItemMemory::Unlink(uint32_t slot)
+{
+	Slot& slotData = m_Slots[slot];
+	if (slotData.previous != UINT32_MAX)
+		m_Slots[slotData.previous].next = slotData.next;
+	else
+		m_MostRecentlySeen = slotData.next;
+
+	if (slotData.next != UINT32_MAX)
+		m_Slots[slotData.next].previous = slotData.previous;
+	else
+		m_LeastRecentlySeen = slotData.previous;
+
+	slotData.previous = slotData.next = UINT32_MAX;
+}
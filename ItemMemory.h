@@ -0,0 +1,121 @@
+#pragma once
+#include <cfloat>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "structs.h"
+#include "SpatialGrid.h"
+#include "PositionQuantizer.h"
+
+// Decoded copy of a remembered item
+struct RememberedItem
+{
+	EntityInfo entity;
+	eItemType type;
+};
+
+// Stays valid until its item is removed, a removed item's handle never resolves to a newer item
+struct ItemHandle
+{
+	uint32_t slot{ UINT32_MAX };
+	uint32_t generation{ 0 };
+
+	bool IsValid() const { return slot != UINT32_MAX; };
+};
+
+// Items on the ground, stored contiguously per item type so a search for one type only touches that type
+// Every type is a structure of arrays of quantized positions and entity hashes, the type itself is implied by the storage
+// New items are deduplicated through a hash on their position quantized to the dedupe distance
+// Items are also kept in a least recently seen list, the eviction candidates come from its tail
+class ItemMemory final
+{
+public:
+	static constexpr size_t TypeCount = static_cast<size_t>(eItemType::_LAST);
+	static constexpr uint32_t AllTypes = (1u << TypeCount) - 1;
+	static constexpr uint32_t GetTypeMask(eItemType type) { return 1u << static_cast<uint32_t>(type); };
+
+	ItemMemory(float cellSize, const PositionQuantizer& quantizer);
+
+	// Returns an invalid handle if an item closer than the dedupe distance is already known, that item is marked as seen instead
+	ItemHandle Add(const EntityInfo& entity, eItemType type, float time);
+	// Returns false if the handle no longer refers to an item
+	bool Remove(ItemHandle handle);
+	void Clear();
+
+	// Returns false if the item was removed
+	bool Get(ItemHandle handle, RememberedItem& item) const;
+	size_t GetCount() const { return m_Count; };
+	size_t GetCount(eItemType type) const { return m_Types[static_cast<size_t>(type)].positions.size(); };
+	// Contiguous records of one type, invalidated by any add or remove
+	const std::vector<QuantizedPosition>& GetPositions(eItemType type) const { return m_Types[static_cast<size_t>(type)].positions; };
+	const std::vector<int>& GetEntityHashes(eItemType type) const { return m_Types[static_cast<size_t>(type)].entityHashes; };
+	// Goes up whenever an item is added or removed
+	uint32_t GetRevision() const { return m_Revision; };
+	// Time the item was last added or seen again, -FLT_MAX if it was removed
+	float GetLastSeen(ItemHandle handle) const;
+	// Furthest item from the position among the given amount of least recently seen items, invalid if there are none
+	ItemHandle FindEvictionCandidate(const Elite::Vector2& position, size_t window) const;
+	// Bytes held by the records, the indices and the hash
+	size_t GetMemoryFootprint() const;
+	// Bytes of a single record's data, the slot, the spatial index and the dedupe hash are bookkeeping on top
+	static constexpr size_t GetRecordSize() { return sizeof(QuantizedPosition) + sizeof(int); };
+
+	// Appends the handles of the items of the masked types within the radius
+	void Query(const Elite::Vector2& center, float radius, std::vector<ItemHandle>& handles, uint32_t typeMask = AllTypes) const;
+private:
+	struct Slot
+	{
+		uint32_t generation{ 0 };
+		// Type in the top bits, index into the items of its type below them, the next free slot while unused
+		uint32_t typeAndIndex{ 0 };
+		float lastSeen{ 0.f };
+		// Least recently seen list
+		uint32_t previous{ UINT32_MAX };
+		uint32_t next{ UINT32_MAX };
+
+		static constexpr uint32_t IndexBits = 29;
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+		uint32_t GetType() const { return typeAndIndex >> IndexBits; };
+		uint32_t GetIndex() const { return typeAndIndex & IndexMask; };
+		void Set(uint32_t type, uint32_t index) { typeAndIndex = type << IndexBits | (index & IndexMask); };
+	};
+	static_assert(TypeCount <= (1u << (32 - Slot::IndexBits)), "Item types don't fit in the slot's type bits");
+
+	struct TypeStorage
+	{
+		std::vector<QuantizedPosition> positions{};
+		std::vector<int> entityHashes{};
+		std::vector<uint32_t> slots{}; // Slot of every item, to fix up the slot when an item moves
+		SpatialGrid grid; // By slot, at the decoded positions
+
+		explicit TypeStorage(float cellSize) : grid(cellSize) {};
+	};
+
+	// Items closer than this are the same item
+	static constexpr float DedupeDistance = 1.f;
+
+	PositionQuantizer m_Quantizer;
+	std::vector<TypeStorage> m_Types{};
+	std::vector<Slot> m_Slots{};
+	uint32_t m_FirstFreeSlot{ UINT32_MAX };
+	size_t m_Count{ 0 };
+	uint32_t m_Revision{ 0 };
+	uint32_t m_MostRecentlySeen{ UINT32_MAX };
+	uint32_t m_LeastRecentlySeen{ UINT32_MAX };
+
+	// Slots by quantized position, the cells are as big as the dedupe distance
+	std::unordered_multimap<uint64_t, uint32_t> m_PositionHash{};
+
+	// Reused query output
+	mutable std::vector<uint32_t> m_QueryResult{};
+
+	static uint64_t GetPositionKey(int cellX, int cellY);
+	static int Quantize(float coordinate);
+	Elite::Vector2 GetLocation(const Slot& slotData) const;
+	RememberedItem Decode(const Slot& slotData) const;
+	// Slot of the item closer than the dedupe distance, UINT32_MAX if there is none
+	uint32_t FindKnown(const Elite::Vector2& location) const;
+	void RemoveFromPositionHash(const Elite::Vector2& location, uint32_t slot);
+	void LinkMostRecent(uint32_t slot);
+	void Unlink(uint32_t slot);
+};
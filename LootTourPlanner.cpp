@@ -0,0 +1,174 @@
+#include "stdafx.h"
+#include "LootTourPlanner.h"
+#include <algorithm>
+#include <chrono>
+#include "WorldMemory.h"
+#include "ConfigManager.h"
+
+bool LootTourPlanner::ContinueRoute(const WorldMemory& worldMemory, uint32_t itemTypeMask, RememberedItem& item)
+{
+	// The planner is shared, a search for other item types needs its own route
+	if (itemTypeMask != m_ItemTypeMask)
+		return false;
+
+	return Advance(worldMemory) && worldMemory.GetItem(m_Stops.back(), item);
+}
+
+bool LootTourPlanner::PlanRoute(const WorldMemory& worldMemory, const Elite::Vector2& position, uint32_t itemTypeMask, RememberedItem& item)
+{
+	Plan(worldMemory, position, itemTypeMask);
+	return !m_Stops.empty() && worldMemory.GetItem(m_Stops.back(), item);
+}
+
+bool LootTourPlanner::Advance(const WorldMemory& worldMemory)
+{
+	if (m_Stops.empty())
+		return false;
+
+	// Looted stops are gone, stops in a purge zone are skipped
+	for (size_t i{ m_Stops.size() }; i > 0; --i)
+	{
+		RememberedItem item{};
+		bool isRemoved = !worldMemory.GetItem(m_Stops[i - 1], item);
+		if (isRemoved)
+			++m_RemovedStops;
+
+		if (isRemoved || worldMemory.IsInPurgeZone(item.entity.Location))
+		{
+			m_Stops.erase(m_Stops.begin() + (i - 1));
+			m_Route.erase(m_Route.begin() + (m_Route.size() - i));
+		}
+	}
+
+	// Every add or remove raises the revision by one, anything beyond our own stops changed the item set
+	return !m_Stops.empty() && worldMemory.GetItems().GetRevision() == m_PlannedRevision + m_RemovedStops;
+}
+
+void LootTourPlanner::Plan(const WorldMemory& worldMemory, const Elite::Vector2& position, uint32_t itemTypeMask)
+{
+	ConfigManager* pConfig = ConfigManager::GetInstance();
+	m_Stops.clear();
+	m_Route.clear();
+	m_PlannedRevision = worldMemory.GetItems().GetRevision();
+	m_RemovedStops = 0;
+	m_ItemTypeMask = itemTypeMask;
+
+	m_Candidates.clear();
+	worldMemory.QueryItems(position, pConfig->GetLootTourRadius(), m_Candidates, itemTypeMask);
+
+	// The agent is the first point, the closest items outside of purge zones follow
+	m_Points.clear();
+	m_Points.push_back(position);
+	m_Candidates.erase(std::remove_if(m_Candidates.begin(), m_Candidates.end(), [&worldMemory](ItemHandle handle)
+		{
+			RememberedItem item{};
+			return !worldMemory.GetItem(handle, item) || worldMemory.IsInPurgeZone(item.entity.Location);
+		}), m_Candidates.end());
+
+	auto getLocation = [&worldMemory](ItemHandle handle)
+	{
+		RememberedItem item{};
+		worldMemory.GetItem(handle, item);
+		return item.entity.Location;
+	};
+	size_t stopCount = std::min(m_Candidates.size(), pConfig->GetLootTourMaxStops());
+	std::partial_sort(m_Candidates.begin(), m_Candidates.begin() + stopCount, m_Candidates.end(),
+		[&position, &getLocation](ItemHandle a, ItemHandle b)
+		{
+			return position.DistanceSquared(getLocation(a)) < position.DistanceSquared(getLocation(b));
+		});
+	m_Candidates.resize(stopCount);
+	if (m_Candidates.empty())
+		return;
+
+	for (ItemHandle handle : m_Candidates)
+	{
+		m_Points.push_back(getLocation(handle));
+	}
+
+	SeedNearestNeighbour();
+	m_SeedLength = GetLength();
+	ImproveTwoOpt(pConfig->GetLootTourBudget());
+	m_PlannedLength = GetLength();
+
+	// Backwards, so the next stop is at the back
+	for (size_t i{ m_Order.size() - 1 }; i > 0; --i)
+	{
+		m_Stops.push_back(m_Candidates[m_Order[i] - 1]);
+	}
+	for (size_t i{ 1 }; i < m_Order.size(); ++i)
+	{
+		m_Route.push_back(m_Points[m_Order[i]]);
+	}
+}
+
+void LootTourPlanner::SeedNearestNeighbour()
+{
+	m_Order.clear();
+	m_Order.push_back(0);
+
+	for (uint32_t i{ 1 }; i < m_Points.size(); ++i)
+	{
+		m_Order.push_back(i);
+	}
+
+	// The points not in the tour yet are kept after the ones that are
+	for (size_t i{ 1 }; i < m_Order.size(); ++i)
+	{
+		const Elite::Vector2& current = m_Points[m_Order[i - 1]];
+		size_t closest{ i };
+		float closestDistanceSq = current.DistanceSquared(m_Points[m_Order[i]]);
+		for (size_t j{ i + 1 }; j < m_Order.size(); ++j)
+		{
+			float distanceSq = current.DistanceSquared(m_Points[m_Order[j]]);
+			if (distanceSq < closestDistanceSq)
+			{
+				closestDistanceSq = distanceSq;
+				closest = j;
+			}
+		}
+		std::swap(m_Order[i], m_Order[closest]);
+	}
+}
+
+void LootTourPlanner::ImproveTwoOpt(float budget)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	auto distance = [this](size_t a, size_t b) { return m_Points[m_Order[a]].Distance(m_Points[m_Order[b]]); };
+
+	// The route is open, it ends at its last stop, so the edge after the last point costs nothing
+	size_t count = m_Order.size();
+	bool improved{ true };
+	while (improved)
+	{
+		improved = false;
+		for (size_t i{ 0 }; i + 2 < count; ++i)
+		{
+			for (size_t j{ i + 2 }; j < count; ++j)
+			{
+				// Reversing i + 1 to j replaces the edges (i, i + 1) and (j, j + 1) with (i, j) and (i + 1, j + 1)
+				float removed = distance(i, i + 1) + (j + 1 < count ? distance(j, j + 1) : 0.f);
+				float added = distance(i, j) + (j + 1 < count ? distance(i + 1, j + 1) : 0.f);
+				if (added < removed - 1e-4f)
+				{
+					std::reverse(m_Order.begin() + i + 1, m_Order.begin() + j + 1);
+					improved = true;
+				}
+			}
+
+			std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+			if (elapsed.count() > budget)
+				return;
+		}
+	}
+}
+
+float LootTourPlanner::GetLength() const
+{
+	float length{ 0.f };
+	for (size_t i{ 1 }; i < m_Order.size(); ++i)
+	{
+		length += m_Points[m_Order[i - 1]].Distance(m_Points[m_Order[i]]);
+	}
+	return length;
+}
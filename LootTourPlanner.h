@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "EliteMath/EMath.h"
+#include "ItemMemory.h"
+
+class WorldMemory;
+
+// Orders the remembered items around the agent into one route, so a pickup only advances the route
+// The route starts as a nearest neighbour tour and is improved with 2-opt until it converges or the time budget runs out
+// Distances are straight lines, the navmesh is only queried for the stop the agent is heading to
+class LootTourPlanner final
+{
+public:
+	// Next stop of the current route, returns false if there is none, the route was planned for other item types
+	// or items other than its own were added or removed
+	bool ContinueRoute(const WorldMemory& worldMemory, uint32_t itemTypeMask, RememberedItem& item);
+	// Plans a new route through the items of the masked types around the position, returns false if there is nothing to loot
+	bool PlanRoute(const WorldMemory& worldMemory, const Elite::Vector2& position, uint32_t itemTypeMask, RememberedItem& item);
+
+	const std::vector<Elite::Vector2>& GetRoute() const { return m_Route; };
+	// Length of the planned route before and after 2-opt, from the agent along every stop
+	float GetSeedLength() const { return m_SeedLength; };
+	float GetPlannedLength() const { return m_PlannedLength; };
+private:
+	// Remaining stops, the next one is at the back so advancing pops it
+	std::vector<ItemHandle> m_Stops{};
+	std::vector<Elite::Vector2> m_Route{}; // Locations of the remaining stops in visiting order, for debug drawing
+	// Item revision the route is valid for, every stop that is gone since raises it by one
+	uint32_t m_PlannedRevision{ 0 };
+	uint32_t m_RemovedStops{ 0 };
+	uint32_t m_ItemTypeMask{ ItemMemory::AllTypes };
+
+	float m_SeedLength{ 0.f };
+	float m_PlannedLength{ 0.f };
+
+	// Reused buffers
+	std::vector<ItemHandle> m_Candidates{};
+	std::vector<Elite::Vector2> m_Points{};
+	std::vector<uint32_t> m_Order{};
+
+	// Drops the stops that were looted or are now in a purge zone, returns false if the route has to be planned again
+	bool Advance(const WorldMemory& worldMemory);
+	void Plan(const WorldMemory& worldMemory, const Elite::Vector2& position, uint32_t itemTypeMask);
+	// Nearest neighbour tour from the first point, which stays first
+	void SeedNearestNeighbour();
+	// Reverses segments while that shortens the open route or until the budget in ms runs out
+	void ImproveTwoOpt(float budget);
+	float GetLength() const;
+};
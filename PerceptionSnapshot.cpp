@@ -0,0 +1,50 @@
+#include "stdafx.h"
+#include "PerceptionSnapshot.h"
+#include "CachedExamInterface.h"
+
+void PerceptionSnapshot::Update(CachedExamInterface* pInterface, uint32_t frame)
+{
+	m_Frame = frame;
+
+	// clear() keeps the capacity
+	m_Entities.clear();
+	m_Enemies.clear();
+	m_Items.clear();
+	m_PurgeZones.clear();
+	m_Houses.clear();
+
+	EntityInfo entityInfo{};
+	for (int i{ 0 }; pInterface->Fov_GetEntityByIndex(i, entityInfo); ++i)
+	{
+		m_Entities.push_back(entityInfo);
+
+		switch (entityInfo.Type)
+		{
+		case eEntityType::ENEMY:
+			m_Enemies.push_back(entityInfo);
+			break;
+		case eEntityType::ITEM:
+		{
+			PerceivedItem item{ entityInfo, ItemInfo{}, false };
+			item.hasInfo = pInterface->Item_GetInfo(entityInfo, item.info);
+			m_Items.push_back(item);
+			break;
+		}
+		case eEntityType::PURGEZONE:
+		{
+			PerceivedPurgeZone purgeZone{ entityInfo, PurgeZoneInfo{} };
+			pInterface->PurgeZone_GetInfo(entityInfo, purgeZone.info);
+			m_PurgeZones.push_back(purgeZone);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	HouseInfo houseInfo{};
+	for (int i{ 0 }; pInterface->Fov_GetHouseByIndex(i, houseInfo); ++i)
+	{
+		m_Houses.push_back(houseInfo);
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Exam_HelperStructs.h"
+
+class CachedExamInterface;
+
+struct PerceivedItem
+{
+	EntityInfo entity;
+	ItemInfo info;
+	bool hasInfo; // False if the interface refused the item lookup
+};
+
+struct PerceivedPurgeZone
+{
+	EntityInfo entity;
+	PurgeZoneInfo info;
+};
+
+// Everything in the agent's FOV for one frame, filled once per tick and shared through the blackboard
+// The buffers are reused between frames so refreshing doesn't allocate once they reached their peak size
+class PerceptionSnapshot final
+{
+public:
+	PerceptionSnapshot() = default;
+
+	void Update(CachedExamInterface* pInterface, uint32_t frame);
+
+	uint32_t GetFrame() const { return m_Frame; };
+	// Every entity in FOV order
+	const std::vector<EntityInfo>& GetEntities() const { return m_Entities; };
+	const std::vector<EntityInfo>& GetEnemies() const { return m_Enemies; };
+	const std::vector<PerceivedItem>& GetItems() const { return m_Items; };
+	const std::vector<PerceivedPurgeZone>& GetPurgeZones() const { return m_PurgeZones; };
+	const std::vector<HouseInfo>& GetHouses() const { return m_Houses; };
+private:
+	uint32_t m_Frame{ 0 };
+	std::vector<EntityInfo> m_Entities{};
+	std::vector<EntityInfo> m_Enemies{};
+	std::vector<PerceivedItem> m_Items{};
+	std::vector<PerceivedPurgeZone> m_PurgeZones{};
+	std::vector<HouseInfo> m_Houses{};
+};
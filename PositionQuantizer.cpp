@@ -0,0 +1,38 @@
+#include "stdafx.h"
+#include "PositionQuantizer.h"
+#include <algorithm>
+
+PositionQuantizer::PositionQuantizer() :
+	PositionQuantizer(Elite::Vector2{ 0.f, 0.f }, Elite::Vector2{ 2000.f, 2000.f })
+{
+}
+
+PositionQuantizer::PositionQuantizer(const Elite::Vector2& worldCenter, const Elite::Vector2& worldDimensions)
+{
+	// Some room around the world so houses and zones on its edge don't get clamped
+	const float boundsScale{ 1.1f };
+	float extent = std::max(std::max(worldDimensions.x, worldDimensions.y), 1.f) * boundsScale;
+	m_Min = Elite::Vector2{ worldCenter.x - extent / 2.f, worldCenter.y - extent / 2.f };
+	m_Step = extent / UINT16_MAX;
+}
+
+QuantizedPosition PositionQuantizer::Encode(const Elite::Vector2& position) const
+{
+	auto encode = [this](float value, float min) -> uint16_t
+	{
+		float steps = roundf((value - min) / m_Step);
+		return static_cast<uint16_t>(std::clamp(steps, 0.f, static_cast<float>(UINT16_MAX)));
+	};
+	return QuantizedPosition{ encode(position.x, m_Min.x), encode(position.y, m_Min.y) };
+}
+
+Elite::Vector2 PositionQuantizer::Decode(QuantizedPosition position) const
+{
+	return Elite::Vector2{ m_Min.x + position.x * m_Step, m_Min.y + position.y * m_Step };
+}
+
+uint16_t PositionQuantizer::EncodeLength(float length) const
+{
+	float steps = roundf(length / m_Step);
+	return static_cast<uint16_t>(std::clamp(steps, 0.f, static_cast<float>(UINT16_MAX)));
+}
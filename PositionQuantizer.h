@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include "EliteMath/EMath.h"
+
+struct QuantizedPosition
+{
+	uint16_t x;
+	uint16_t y;
+
+	bool operator==(const QuantizedPosition& other) const { return x == other.x && y == other.y; };
+};
+
+// Maps world positions to 16 bits per axis over the world bounds, both axes share one step so lengths can be quantized too
+// Decoding is off by at most half a step per axis, far below the margins the rect and circle tests use
+class PositionQuantizer final
+{
+public:
+	// Bounds default to a 2000 unit world around the origin until the real bounds are known
+	PositionQuantizer();
+	PositionQuantizer(const Elite::Vector2& worldCenter, const Elite::Vector2& worldDimensions);
+
+	// Positions outside of the bounds are clamped to them
+	QuantizedPosition Encode(const Elite::Vector2& position) const;
+	Elite::Vector2 Decode(QuantizedPosition position) const;
+	uint16_t EncodeLength(float length) const;
+	float DecodeLength(uint16_t length) const { return length * m_Step; };
+
+	float GetStep() const { return m_Step; };
+	const Elite::Vector2& GetMin() const { return m_Min; };
+private:
+	Elite::Vector2 m_Min{};
+	float m_Step{ 1.f };
+};
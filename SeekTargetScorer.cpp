@@ -0,0 +1,150 @@
+#include "stdafx.h"
+#include "SeekTargetScorer.h"
+#include <algorithm>
+#include <cmath>
+#include <xmmintrin.h>
+#include "WorldMemory.h"
+#include "ConfigManager.h"
+
+const std::vector<SeekTarget>& SeekTargetScorer::Score(WorldMemory& worldMemory, const Elite::Vector2& position, size_t count,
+	uint32_t itemTypeMask)
+{
+	// Houses whose loot epoch came join the candidates
+	worldMemory.UpdateRevisitSchedule();
+
+	uint32_t revision = worldMemory.GetRevision();
+	if (revision == m_Revision && position == m_Position && count == m_Count && itemTypeMask == m_ItemTypeMask)
+		return m_Targets;
+
+	m_Revision = revision;
+	m_Position = position;
+	m_Count = count;
+	m_ItemTypeMask = itemTypeMask;
+
+	Gather(worldMemory, itemTypeMask);
+	ComputeScores(worldMemory, position);
+	SelectBest(count);
+	return m_Targets;
+}
+
+void SeekTargetScorer::Gather(const WorldMemory& worldMemory, uint32_t itemTypeMask)
+{
+	m_X.clear();
+	m_Y.clear();
+	m_Weights.clear();
+	m_Tiers.clear();
+	m_Types.clear();
+	m_Ids.clear();
+	m_ItemTypes.clear();
+
+	ConfigManager* pConfig = ConfigManager::GetInstance();
+	const PositionQuantizer& quantizer = worldMemory.GetQuantizer();
+
+	// An item closer than a house wins, corners are only visited when there is nothing else
+	const ItemMemory& items = worldMemory.GetItems();
+	for (size_t type{ 0 }; type < ItemMemory::TypeCount; ++type)
+	{
+		if ((itemTypeMask & (1u << type)) == 0)
+			continue;
+
+		eItemType itemType = static_cast<eItemType>(type);
+		const std::vector<QuantizedPosition>& positions = items.GetPositions(itemType);
+		const std::vector<int>& entityHashes = items.GetEntityHashes(itemType);
+		for (size_t i{ 0 }; i < positions.size(); ++i)
+		{
+			AddCandidate(quantizer.Decode(positions[i]), SeekTargetType::ITEM, 0, pConfig->GetSeekItemWeight(), entityHashes[i], itemType);
+		}
+	}
+
+	// Only the houses that had enough items looted since they were explored
+	const std::vector<uint32_t>& houses = worldMemory.GetRevisitHouses();
+	const std::vector<Elite::Vector2>& houseCenters = worldMemory.GetRevisitCenters();
+	for (size_t i{ 0 }; i < houses.size(); ++i)
+	{
+		AddCandidate(houseCenters[i], SeekTargetType::HOUSE, 0, pConfig->GetSeekHouseWeight(), static_cast<int>(houses[i]), eItemType::_LAST);
+	}
+
+	const std::vector<QuantizedPosition>& corners = worldMemory.GetCorners();
+	for (size_t i{ 0 }; i < corners.size(); ++i)
+	{
+		AddCandidate(quantizer.Decode(corners[i]), SeekTargetType::CORNER, 1, pConfig->GetSeekCornerWeight(), static_cast<int>(i), eItemType::_LAST);
+	}
+
+	// Pad so the kernels never need a scalar tail, the padding is never selected
+	m_CandidateCount = m_X.size();
+	size_t paddedCount = (m_CandidateCount + 3) / 4 * 4;
+	m_X.resize(paddedCount, 0.f);
+	m_Y.resize(paddedCount, 0.f);
+	m_Weights.resize(paddedCount, 0.f);
+	m_Scores.resize(paddedCount);
+}
+
+void SeekTargetScorer::AddCandidate(const Elite::Vector2& location, SeekTargetType type, uint8_t tier, float weight, int id, eItemType itemType)
+{
+	m_X.push_back(location.x);
+	m_Y.push_back(location.y);
+	m_Weights.push_back(weight);
+	m_Tiers.push_back(tier);
+	m_Types.push_back(type);
+	m_Ids.push_back(id);
+	m_ItemTypes.push_back(itemType);
+}
+
+void SeekTargetScorer::ComputeScores(const WorldMemory& worldMemory, const Elite::Vector2& position)
+{
+	const __m128 positionX = _mm_set1_ps(position.x);
+	const __m128 positionY = _mm_set1_ps(position.y);
+	for (size_t i{ 0 }; i < m_Scores.size(); i += 4)
+	{
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(&m_X[i]), positionX);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(&m_Y[i]), positionY);
+		__m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		_mm_storeu_ps(&m_Scores[i], _mm_mul_ps(distanceSq, _mm_loadu_ps(&m_Weights[i])));
+	}
+
+	// Every zone against four candidates at a time, candidates inside get an infinite score
+	const __m128 excluded = _mm_set1_ps(INFINITY);
+	for (uint32_t zone{ 0 }; zone < worldMemory.GetPurgeZoneCount(); ++zone)
+	{
+		PurgeZoneInfo purgeZoneInfo = worldMemory.GetPurgeZone(zone);
+		const __m128 centerX = _mm_set1_ps(purgeZoneInfo.Center.x);
+		const __m128 centerY = _mm_set1_ps(purgeZoneInfo.Center.y);
+		const __m128 radiusSq = _mm_set1_ps(purgeZoneInfo.Radius * purgeZoneInfo.Radius);
+		for (size_t i{ 0 }; i < m_Scores.size(); i += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(&m_X[i]), centerX);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(&m_Y[i]), centerY);
+			// Inclusive like utils::IsPointInCircle
+			__m128 inside = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), radiusSq);
+			__m128 scores = _mm_loadu_ps(&m_Scores[i]);
+			_mm_storeu_ps(&m_Scores[i], _mm_or_ps(_mm_and_ps(inside, excluded), _mm_andnot_ps(inside, scores)));
+		}
+	}
+}
+
+void SeekTargetScorer::SelectBest(size_t count)
+{
+	m_Order.clear();
+	for (uint32_t i{ 0 }; i < m_CandidateCount; ++i)
+	{
+		if (m_Scores[i] != INFINITY)
+			m_Order.push_back(i);
+	}
+
+	auto isBetter = [this](uint32_t a, uint32_t b)
+	{
+		if (m_Tiers[a] != m_Tiers[b])
+			return m_Tiers[a] < m_Tiers[b];
+		return m_Scores[a] < m_Scores[b];
+	};
+	size_t selectedCount = std::min(count, m_Order.size());
+	std::partial_sort(m_Order.begin(), m_Order.begin() + selectedCount, m_Order.end(), isBetter);
+
+	m_Targets.clear();
+	for (size_t i{ 0 }; i < selectedCount; ++i)
+	{
+		uint32_t candidate = m_Order[i];
+		m_Targets.push_back(SeekTarget{ m_Types[candidate], Elite::Vector2{ m_X[candidate], m_Y[candidate] }, m_Scores[candidate],
+			m_Ids[candidate], m_ItemTypes[candidate] });
+	}
+}
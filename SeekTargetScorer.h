@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "EliteMath/EMath.h"
+#include "ItemMemory.h"
+
+class WorldMemory;
+
+enum class SeekTargetType : uint8_t
+{
+	ITEM,
+	HOUSE,
+	CORNER
+};
+
+struct SeekTarget
+{
+	SeekTargetType type;
+	Elite::Vector2 location;
+	float score; // Lower is better
+	// Entity hash and item type for items, house index for houses, corner index for corners
+	int id;
+	eItemType itemType;
+};
+
+// Scores every remembered item, house worth a revisit and corner in one pass over contiguous arrays
+// The score is the weighted squared distance, corners always come after items and houses and
+// candidates in a known purge zone are dropped. Distances and the purge zone test run four candidates at a time with SSE
+// Results are kept until the position, the mask or the world memory changes, so every search action can reuse them
+class SeekTargetScorer final
+{
+public:
+	// Best targets first, at most the given amount
+	const std::vector<SeekTarget>& Score(WorldMemory& worldMemory, const Elite::Vector2& position, size_t count,
+		uint32_t itemTypeMask = ItemMemory::AllTypes);
+	const std::vector<SeekTarget>& GetTargets() const { return m_Targets; };
+private:
+	// Candidates as a structure of arrays, padded to a multiple of four
+	std::vector<float> m_X{};
+	std::vector<float> m_Y{};
+	std::vector<float> m_Weights{};
+	std::vector<float> m_Scores{};
+	std::vector<uint8_t> m_Tiers{}; // Compared before the score, corners are in a later tier than items and houses
+	std::vector<SeekTargetType> m_Types{};
+	std::vector<int> m_Ids{};
+	std::vector<eItemType> m_ItemTypes{};
+	std::vector<uint32_t> m_Order{};
+	size_t m_CandidateCount{ 0 };
+
+	std::vector<SeekTarget> m_Targets{};
+
+	// What the targets were scored for
+	uint32_t m_Revision{ UINT32_MAX };
+	Elite::Vector2 m_Position{};
+	size_t m_Count{ 0 };
+	uint32_t m_ItemTypeMask{ 0 };
+
+	void Gather(const WorldMemory& worldMemory, uint32_t itemTypeMask);
+	void AddCandidate(const Elite::Vector2& location, SeekTargetType type, uint8_t tier, float weight, int id, eItemType itemType);
+	void ComputeScores(const WorldMemory& worldMemory, const Elite::Vector2& position);
+	void SelectBest(size_t count);
+};
@@ -0,0 +1,141 @@
+#include "stdafx.h"
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid(float cellSize) :
+	m_CellSize(cellSize > 0.f ? cellSize : 1.f)
+{
+}
+
+void SpatialGrid::Insert(uint32_t id, const Elite::Vector2& position)
+{
+	int cellX = ToCell(position.x);
+	int cellY = ToCell(position.y);
+	m_Cells[GetCellKey(cellX, cellY)].push_back(Entry{ id, position });
+	++m_Count;
+
+	if (m_MaxCellX < m_MinCellX)
+	{
+		m_MinCellX = m_MaxCellX = cellX;
+		m_MinCellY = m_MaxCellY = cellY;
+	}
+	else
+	{
+		m_MinCellX = std::min(m_MinCellX, cellX);
+		m_MaxCellX = std::max(m_MaxCellX, cellX);
+		m_MinCellY = std::min(m_MinCellY, cellY);
+		m_MaxCellY = std::max(m_MaxCellY, cellY);
+	}
+}
+
+bool SpatialGrid::Remove(uint32_t id, const Elite::Vector2& position)
+{
+	auto cellIt = m_Cells.find(GetCellKey(ToCell(position.x), ToCell(position.y)));
+	if (cellIt == m_Cells.end())
+		return false;
+
+	std::vector<Entry>& cell = cellIt->second;
+	for (size_t i{ 0 }; i < cell.size(); ++i)
+	{
+		if (cell[i].id == id)
+		{
+			// Order inside a cell doesn't matter
+			cell[i] = cell.back();
+			cell.pop_back();
+			--m_Count;
+
+			// Drop empty cells so memory follows the entry count, not the area that was ever visited
+			if (cell.empty())
+				m_Cells.erase(cellIt);
+			return true;
+		}
+	}
+	return false;
+}
+
+void SpatialGrid::Clear()
+{
+	m_Cells.clear();
+	m_Count = 0;
+	m_MinCellX = m_MinCellY = 0;
+	m_MaxCellX = m_MaxCellY = -1;
+}
+
+size_t SpatialGrid::GetMemoryFootprint() const
+{
+	// Every cell is a node with a next pointer, plus one pointer per bucket
+	size_t bytes = m_Cells.size() * (sizeof(std::pair<const uint64_t, std::vector<Entry>>) + sizeof(void*))
+		+ m_Cells.bucket_count() * sizeof(void*);
+	for (const auto& cell : m_Cells)
+	{
+		bytes += cell.second.capacity() * sizeof(Entry);
+	}
+	return bytes;
+}
+
+void SpatialGrid::QueryRadius(const Elite::Vector2& center, float radius, std::vector<uint32_t>& ids) const
+{
+	float radiusSq = radius * radius;
+	int minX = ToCell(center.x - radius), maxX = ToCell(center.x + radius);
+	int minY = ToCell(center.y - radius), maxY = ToCell(center.y + radius);
+	for (int y{ minY }; y <= maxY; ++y)
+	{
+		for (int x{ minX }; x <= maxX; ++x)
+		{
+			const std::vector<Entry>* pCell = FindCell(x, y);
+			if (!pCell)
+				continue;
+
+			for (const Entry& entry : *pCell)
+			{
+				if (center.DistanceSquared(entry.position) <= radiusSq)
+					ids.push_back(entry.id);
+			}
+		}
+	}
+}
+
+void SpatialGrid::QueryAABB(const Elite::Vector2& min, const Elite::Vector2& max, std::vector<uint32_t>& ids) const
+{
+	int minX = ToCell(min.x), maxX = ToCell(max.x);
+	int minY = ToCell(min.y), maxY = ToCell(max.y);
+	for (int y{ minY }; y <= maxY; ++y)
+	{
+		for (int x{ minX }; x <= maxX; ++x)
+		{
+			const std::vector<Entry>* pCell = FindCell(x, y);
+			if (!pCell)
+				continue;
+
+			for (const Entry& entry : *pCell)
+			{
+				const Elite::Vector2& p = entry.position;
+				if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y)
+					ids.push_back(entry.id);
+			}
+		}
+	}
+}
+
+int SpatialGrid::ToCell(float coordinate) const
+{
+	return static_cast<int>(floorf(coordinate / m_CellSize));
+}
+
+uint64_t SpatialGrid::GetCellKey(int cellX, int cellY)
+{
+	return static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32 | static_cast<uint32_t>(cellY);
+}
+
+const std::vector<SpatialGrid::Entry>* SpatialGrid::FindCell(int cellX, int cellY) const
+{
+	auto cellIt = m_Cells.find(GetCellKey(cellX, cellY));
+	if (cellIt == m_Cells.end() || cellIt->second.empty())
+		return nullptr;
+	return &cellIt->second;
+}
+
+int SpatialGrid::GetMaxRing(int cellX, int cellY) const
+{
+	int ring = std::max(std::abs(cellX - m_MinCellX), std::abs(cellX - m_MaxCellX));
+	return std::max(ring, std::max(std::abs(cellY - m_MinCellY), std::abs(cellY - m_MaxCellY)));
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include <cfloat>
+#include <cstdint>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "EliteMath/EMath.h"
+
+// Uniform grid of ids by position, cells are created on demand so the world bounds don't have to be known
+// Nearest queries search outwards ring by ring and stop once no unvisited cell can hold anything closer
+class SpatialGrid final
+{
+public:
+	explicit SpatialGrid(float cellSize);
+
+	void Insert(uint32_t id, const Elite::Vector2& position);
+	// The position has to be the one the id was inserted with
+	bool Remove(uint32_t id, const Elite::Vector2& position);
+	void Clear();
+
+	size_t GetCount() const { return m_Count; };
+	float GetCellSize() const { return m_CellSize; };
+	// Bytes held by the cells and their entries
+	size_t GetMemoryFootprint() const;
+
+	// Appends every id within the radius or box, the output isn't cleared
+	void QueryRadius(const Elite::Vector2& center, float radius, std::vector<uint32_t>& ids) const;
+	void QueryAABB(const Elite::Vector2& min, const Elite::Vector2& max, std::vector<uint32_t>& ids) const;
+
+	// Closest id the predicate accepts, returns false if there is none
+	template<typename Predicate>
+	bool FindNearest(const Elite::Vector2& position, Predicate accept, uint32_t& id) const;
+	// Up to k of the closest ids the predicate accepts, closest first
+	template<typename Predicate>
+	void FindKNearest(const Elite::Vector2& position, size_t k, Predicate accept, std::vector<uint32_t>& ids) const;
+private:
+	struct Entry
+	{
+		uint32_t id;
+		Elite::Vector2 position;
+	};
+
+	float m_CellSize;
+	std::unordered_map<uint64_t, std::vector<Entry>> m_Cells{};
+	size_t m_Count{ 0 };
+	// Bounds of every cell that ever held an entry, limits how far the ring search has to go
+	int m_MinCellX{ 0 }, m_MinCellY{ 0 }, m_MaxCellX{ -1 }, m_MaxCellY{ -1 };
+
+	int ToCell(float coordinate) const;
+	static uint64_t GetCellKey(int cellX, int cellY);
+	const std::vector<Entry>* FindCell(int cellX, int cellY) const;
+	// Amount of rings around the cell that still overlap the occupied bounds
+	int GetMaxRing(int cellX, int cellY) const;
+
+	// Calls visit for every entry in the cells at exactly the given ring around the center cell
+	template<typename Visitor>
+	void VisitRing(int centerX, int centerY, int ring, Visitor visit) const;
+};
+
+template<typename Visitor>
+void SpatialGrid::VisitRing(int centerX, int centerY, int ring, Visitor visit) const
+{
+	auto visitCell = [&](int cellX, int cellY)
+	{
+		if (const std::vector<Entry>* pCell = FindCell(cellX, cellY))
+		{
+			for (const Entry& entry : *pCell)
+				visit(entry);
+		}
+	};
+
+	if (ring == 0)
+	{
+		visitCell(centerX, centerY);
+		return;
+	}
+
+	// Top and bottom rows, then the columns between them
+	for (int x{ centerX - ring }; x <= centerX + ring; ++x)
+	{
+		visitCell(x, centerY - ring);
+		visitCell(x, centerY + ring);
+	}
+	for (int y{ centerY - ring + 1 }; y < centerY + ring; ++y)
+	{
+		visitCell(centerX - ring, y);
+		visitCell(centerX + ring, y);
+	}
+}
+
+template<typename Predicate>
+bool SpatialGrid::FindNearest(const Elite::Vector2& position, Predicate accept, uint32_t& id) const
+{
+	if (m_Count == 0)
+		return false;
+
+	int cellX = ToCell(position.x);
+	int cellY = ToCell(position.y);
+	int maxRing = GetMaxRing(cellX, cellY);
+
+	bool found{ false };
+	float closestDistanceSq{ FLT_MAX };
+	for (int ring{ 0 }; ring <= maxRing; ++ring)
+	{
+		VisitRing(cellX, cellY, ring, [&](const Entry& entry)
+			{
+				float distanceSq = position.DistanceSquared(entry.position);
+				if (distanceSq < closestDistanceSq && accept(entry.id))
+				{
+					closestDistanceSq = distanceSq;
+					id = entry.id;
+					found = true;
+				}
+			});
+
+		// Everything beyond this ring is at least ring cells away
+		float ringDistance = ring * m_CellSize;
+		if (found && closestDistanceSq <= ringDistance * ringDistance)
+			break;
+	}
+	return found;
+}
+
+template<typename Predicate>
+void SpatialGrid::FindKNearest(const Elite::Vector2& position, size_t k, Predicate accept, std::vector<uint32_t>& ids) const
+{
+	ids.clear();
+	if (m_Count == 0 || k == 0)
+		return;
+
+	int cellX = ToCell(position.x);
+	int cellY = ToCell(position.y);
+	int maxRing = GetMaxRing(cellX, cellY);
+
+	// Max heap on distance, the furthest of the k best is on top
+	std::priority_queue<std::pair<float, uint32_t>> best{};
+	for (int ring{ 0 }; ring <= maxRing; ++ring)
+	{
+		VisitRing(cellX, cellY, ring, [&](const Entry& entry)
+			{
+				float distanceSq = position.DistanceSquared(entry.position);
+				if (best.size() == k && distanceSq >= best.top().first)
+					return;
+				if (!accept(entry.id))
+					return;
+
+				best.push({ distanceSq, entry.id });
+				if (best.size() > k)
+					best.pop();
+			});
+
+		float ringDistance = ring * m_CellSize;
+		if (best.size() == k && best.top().first <= ringDistance * ringDistance)
+			break;
+	}
+
+	ids.resize(best.size());
+	for (size_t i{ best.size() }; i > 0; --i)
+	{
+		ids[i - 1] = best.top().second;
+		best.pop();
+	}
+}
@@ -1,16 +1,21 @@
 #include "stdafx.h"
 #include "StatesAndTransitions.h"
+#include "BlackboardKeys.h"
 #include "Agent.h"
 #include "GOAPPlanner.h"
 #include "DebugOutputManager.h"
 #include "ConfigManager.h"
+#include "TickScheduler.h"
+#include "AILevelOfDetail.h"
+#include "CachedExamInterface.h"
+#include "InterfaceProfiler.h"
 
 // STATES
 // ------------------------------------------------------------------------------------------------------------------------------------------------
 /// IdleState: public FSMState
 void IdleState::OnEnter(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
 {
-	ResetIdleState();
+	ResetIdleState(pBlackboard);
 
 	// The last action encountered a problem with fullfilling it's effects. Replan!
 	if (pPlanner->GetEncounteredProblem() == true)
@@ -19,7 +24,6 @@ void IdleState::OnEnter(IExamInterface* pInterface, GOAPPlanner* pPlanner, Black
 			DebugOutputManager::DebugType::FSM_STATE);
 
 		pPlanner->SetEncounteredProblem(false);
-		m_ActionTimer = m_RefreshActionTime + 1.f;
 		m_ReplanActions = true;
 		return;
 	}
@@ -29,7 +33,7 @@ void IdleState::OnEnter(IExamInterface* pInterface, GOAPPlanner* pPlanner, Black
 	if (pAction)
 	{
 		pPlanner->NextAction();
-		if (pPlanner->GetAction())
+		if (ChainInstantActions(pInterface, pPlanner, pBlackboard))
 		{
 			// Next action exists
 			m_HasNext = true;
@@ -41,35 +45,58 @@ void IdleState::OnEnter(IExamInterface* pInterface, GOAPPlanner* pPlanner, Black
 }
 void IdleState::Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float deltaTime)
 {
+	InterfaceProfileScope profileScope{ "IdleState" };
 	// Don't need a new plan if we have a next action
 	if (m_HasNext)
 		return;
 
-	// Only plan actions every x seconds
-	if (m_ActionTimer > m_RefreshActionTime)
+	TickScheduler* pScheduler = nullptr;
+	pBlackboard->GetData(BlackboardKeys::TICK_SCHEDULER, pScheduler);
+
+	// Only plan actions at the planner rate
+	if (pScheduler && pScheduler->TryRun(ScheduledTask::PLANNER))
 	{
 		DebugOutputManager::GetInstance()->DebugLine("Searching for possible actions...\n",
 			DebugOutputManager::DebugType::FSM_STATE);
-
-		// Reset action timer
-		m_ActionTimer = 0.f;
+		ScopedTaskCost taskCost{ pScheduler, ScheduledTask::PLANNER };
 
 		// Plan the action until one is found
 		bool plannedAction = pPlanner->PlanAction();
-		if (plannedAction)
+		if (plannedAction && ChainInstantActions(pInterface, pPlanner, pBlackboard))
 		{
 			DebugOutputManager::GetInstance()->DebugLine("Planned actions, currentAction: " + pPlanner->GetAction()->ToString() + "\n",
 				DebugOutputManager::DebugType::FSM_STATE);
 		}
 	}
-	else
-		m_ActionTimer += deltaTime;
 }
-void IdleState::ResetIdleState()
+void IdleState::ResetIdleState(Blackboard* pBlackboard)
 {
-	m_ActionTimer = m_RefreshActionTime;
 	m_HasNext = false;
 	m_ReplanActions = false;
+
+	// Plan on the first update in idle
+	TickScheduler* pScheduler = nullptr;
+	if (pBlackboard->GetData(BlackboardKeys::TICK_SCHEDULER, pScheduler) && pScheduler)
+		pScheduler->Trigger(ScheduledTask::PLANNER);
+}
+bool IdleState::ChainInstantActions(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
+{
+	int budget = ConfigManager::GetInstance()->GetInstantActionBudget();
+	if (budget > 0)
+		pPlanner->PerformInstantActions(pInterface, pBlackboard, budget);
+
+	// A chained action failed or the plan ran out, replan on the next update
+	if (pPlanner->GetEncounteredProblem() || !pPlanner->GetAction())
+	{
+		pPlanner->SetEncounteredProblem(false);
+		m_HasNext = false;
+
+		TickScheduler* pScheduler = nullptr;
+		if (pBlackboard->GetData(BlackboardKeys::TICK_SCHEDULER, pScheduler) && pScheduler)
+			pScheduler->Trigger(ScheduledTask::PLANNER);
+		return false;
+	}
+	return true;
 }
 
 // GoToState: public FSMState
@@ -79,12 +106,15 @@ void GoToState::OnEnter(IExamInterface* pInterface, GOAPPlanner* pPlanner, Black
 	// Setup the action
 	pPlanner->GetAction()->Setup(pInterface, pPlanner, pBlackboard);
 
-	// Setup GoTo state
-	m_PathRefreshTimer = m_PathRefreshDuration;
+	// Setup GoTo state, fetch a path on the first update
+	m_pArrivedAction = nullptr;
+	TickScheduler* pScheduler = nullptr;
+	if (pBlackboard->GetData(BlackboardKeys::TICK_SCHEDULER, pScheduler) && pScheduler)
+		pScheduler->Trigger(ScheduledTask::PATH_REFRESH);
 
 	// Get the agent
 	Agent* pAgent = nullptr;
-	bool foundData = pBlackboard->GetData("Agent", pAgent);
+	bool foundData = pBlackboard->GetData(BlackboardKeys::AGENT, pAgent);
 	if (!foundData)
 	{
 		DebugOutputManager::GetInstance()->DebugLine("GoToState::OnEnter, problem fetching data from blackboard\n",
@@ -99,7 +129,7 @@ void GoToState::OnExit(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackb
 {
 	// Get the agent
 	Agent* pAgent = nullptr;
-	bool foundData = pBlackboard->GetData("Agent", pAgent);
+	bool foundData = pBlackboard->GetData(BlackboardKeys::AGENT, pAgent);
 	if (!foundData)
 	{
 		DebugOutputManager::GetInstance()->DebugLine("GoToState::OnExit, problem fetching data from blackboard\n",
@@ -112,8 +142,13 @@ void GoToState::OnExit(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackb
 }
 void GoToState::Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float deltaTime)
 {
+	InterfaceProfileScope profileScope{ "GoToState" };
 	Agent* pAgent = nullptr;
-	bool foundData = pBlackboard->GetData("Agent", pAgent);
+	TickScheduler* pScheduler = nullptr;
+	CachedExamInterface* pInterfaceCache = nullptr;
+	bool foundData = pBlackboard->GetData(BlackboardKeys::AGENT, pAgent)
+		&& pBlackboard->GetData(BlackboardKeys::TICK_SCHEDULER, pScheduler)
+		&& pBlackboard->GetData(BlackboardKeys::INTERFACE_CACHE, pInterfaceCache);
 	if (!foundData)
 	{
 		DebugOutputManager::GetInstance()->DebugLine("GoToState::Update, problem fetching data from blackboard\n",
@@ -121,19 +156,28 @@ void GoToState::Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackb
 		return;
 	}
 
-	AgentInfo agentInfo = pInterface->Agent_GetInfo();
+	const AgentInfo& agentInfo = pInterfaceCache->Agent_GetInfo();
 	Elite::Vector2 currentAgentPosition = agentInfo.Position;
 
-	// Only fetch a new path every x frames
-	if (m_PathRefreshTimer >= m_PathRefreshDuration)
+	// Only fetch a new path at the path refresh rate
+	if (pScheduler->TryRun(ScheduledTask::PATH_REFRESH))
 	{
-		m_PathRefreshTimer = 0.f;
-		Elite::Vector2 closestNode = pInterface->NavMesh_GetClosestPathPoint(pPlanner->GetAction()->GetMoveLocation());
+		ScopedTaskCost taskCost{ pScheduler, ScheduledTask::PATH_REFRESH };
+		Elite::Vector2 closestNode = pInterfaceCache->NavMesh_GetClosestPathPoint(pPlanner->GetAction()->GetMoveLocation());
 		pAgent->SetSeekPos(closestNode);
 	}
-	m_PathRefreshTimer += deltaTime;
 
-	if (ConfigManager::GetInstance()->GetDebugGoalPosition())
+	// Tell an event driven FSM once the action no longer needs movement, a polling FSM checks PerformTransition itself
+	GOAPAction* pAction = pPlanner->GetAction();
+	if (pPlanner->IsEventDriven() && pAction != m_pArrivedAction && !pAction->RequiresMovement(pInterface, pPlanner, pBlackboard))
+	{
+		m_pArrivedAction = pAction;
+		pPlanner->RaiseEvent(FSMEvent::MOVEMENT_FULFILLED);
+	}
+
+	AILevelOfDetail* pLevelOfDetail = nullptr;
+	pBlackboard->GetData(BlackboardKeys::LEVEL_OF_DETAIL, pLevelOfDetail);
+	if (ConfigManager::GetInstance()->GetDebugGoalPosition() && (!pLevelOfDetail || pLevelOfDetail->AllowDebugDraw()))
 		pInterface->Draw_SolidCircle(pPlanner->GetAction()->GetMoveLocation(), .5f, Elite::Vector2{}, Elite::Vector3{ 0.f, 1.f, 0.f });
 }
 
@@ -141,10 +185,41 @@ void GoToState::Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackb
 void PerformState::OnEnter(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
 {
 	// Setup the action
-	pPlanner->GetAction()->Setup(pInterface, pPlanner, pBlackboard);
+	GOAPAction* pAction = pPlanner->GetAction();
+	InterfaceProfileScope profileScope{ pAction->GetName().c_str() };
+	pAction->Setup(pInterface, pPlanner, pBlackboard);
+
+	// Start the coroutine, it runs on the first update
+	if (pAction->IsCoroutine() && ConfigManager::GetInstance()->GetCoroutineActions())
+		m_Task = pAction->Execute(pInterface, pPlanner, pBlackboard);
+}
+void PerformState::OnExit(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
+{
+	// Destroys the coroutine frame if the action was interrupted
+	m_Task = ActionTask{};
 }
 void PerformState::Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float deltaTime)
 {
+	// Interface calls are attributed to the performed action
+	InterfaceProfileScope profileScope{ pPlanner->GetAction()->GetName().c_str() };
+
+	if (m_Task.IsValid())
+	{
+		// Wait in the finished state for PerformedTransition
+		if (m_Task.IsFinished())
+			return;
+
+		// A suspended coroutine only checks its wake condition
+		if (m_Task.Tick(deltaTime))
+		{
+			if (m_Task.Succeeded())
+				pPlanner->RaiseEvent(FSMEvent::ACTION_DONE);
+			else
+				pPlanner->SetEncounteredProblem(true);
+		}
+		return;
+	}
+
 	// Perform until the action is done
 	bool performed = pPlanner->GetAction()->Perform(pInterface, pPlanner, pBlackboard, deltaTime);
 
@@ -8,6 +8,7 @@
 #include "SteeringBehaviors.h"
 #include "Blackboard.h"
 #include "FSMState.h"
+#include "StaticFSM.h"
 
 // STATES
 // -----------
@@ -17,52 +18,75 @@ public:
 	virtual void OnEnter(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) override;
 	virtual void Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float deltaTime) override;
 private:
-	float m_TimePerActionCheck = .5f;
-	float m_RefreshActionTime{ 1.f };
-	float m_ActionTimer = 1.f;
 	bool m_HasNext = false;
 	bool m_ReplanActions = false;
 
-	void ResetIdleState();
+	void ResetIdleState(Blackboard* pBlackboard);
+	// Runs instant actions of the plan this frame, returns false when nothing is left to transition to
+	bool ChainInstantActions(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard);
 };
 
-class GoToState: public FSMState
+class GoToState final : public FSMState
 {
 public:
 	virtual void OnEnter(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) override;
 	virtual void OnExit(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) override;
 	virtual void Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float deltaTime) override;
 private:
-	float m_PathRefreshDuration = 0.1f;
-	float m_PathRefreshTimer = 0.f;
+	// The action MOVEMENT_FULFILLED was raised for, so it's only raised once
+	GOAPAction* m_pArrivedAction = nullptr;
 };
 
-class PerformState : public FSMState
+class PerformState final : public FSMState
 {
 public:
 	virtual void OnEnter(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) override;
+	virtual void OnExit(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) override;
 	virtual void Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float deltaTime) override;
+private:
+	// Only valid while performing a coroutine action
+	ActionTask m_Task{};
 };
 
 // TRANSITIONS
 // -----------
-class GoToTransition : public FSMTransition
+class GoToTransition final : public FSMTransition
 {
 public:
 	GoToTransition() = default;
 	virtual bool ToTransition(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const override;
+	virtual FSMEventMask GetTriggerEvents() const override { return FSMEvent::ACTION_CHANGED | FSMEvent::MOVEMENT_REQUIRED; };
 };
 
-class PerformTransition : public FSMTransition
+class PerformTransition final : public FSMTransition
 {
 public:
 	PerformTransition() = default;
 	virtual bool ToTransition(IExamInterface* pInterface, GOAPPlanner * pPlanner, Blackboard * pBlackboard) const override;
+	virtual FSMEventMask GetTriggerEvents() const override { return FSMEvent::ACTION_CHANGED | FSMEvent::MOVEMENT_FULFILLED; };
 };
 
-class PerformedTransition : public FSMTransition
+class PerformedTransition final : public FSMTransition
 {
 public:
 	PerformedTransition() = default;
 	virtual bool ToTransition(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const override;
-};
\ No newline at end of file
+	virtual FSMEventMask GetTriggerEvents() const override { return FSMEvent::ACTION_DONE | FSMEvent::PROBLEM_ENCOUNTERED; };
+};
+
+// COMPILE TIME FSM
+// -----------
+// Same wiring as Agent::InitializeFSM builds for the runtime FiniteStateMachine
+using AgentStaticFSM = StaticFiniteStateMachine<
+	StaticTransitionTable<
+		// The action requires movement before performing, go to GoTo state
+		StaticTransition<IdleState, GoToState, GoToTransition>,
+		// The action doesn't require any movement, go to perform state
+		StaticTransition<IdleState, PerformState, PerformTransition>,
+		// Once movement is done, perform the action
+		StaticTransition<GoToState, PerformState, PerformTransition>,
+		// Action required more movement while performing, go back to movement state
+		StaticTransition<PerformState, GoToState, GoToTransition>,
+		// Action IsDone, go back to idle to recalculate path or choose the next action
+		StaticTransition<PerformState, IdleState, PerformedTransition>>,
+	IdleState, GoToState, PerformState>;
\ No newline at end of file
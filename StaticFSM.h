@@ -0,0 +1,114 @@
+#pragma once
+/*=============================================================================*/
+// StaticFSM.h: Compile time counterpart of the FiniteStateMachine in FSMState.h
+// The states and the transition table are template parameters, so every state and
+// transition call is resolved at compile time and can be inlined (mark them final)
+/*=============================================================================*/
+
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <variant>
+#include <type_traits>
+#include "DecisionMaking.h"
+#include "FSMEvents.h"
+#include "GOAPPlanner.h"
+#include "DebugOutputManager.h"
+
+class Blackboard;
+class IExamInterface;
+
+// A transition from From to To, taken when a default constructed Condition returns true from ToTransition
+template<typename From, typename To, typename Condition>
+struct StaticTransition
+{
+	using FromState = From;
+	using ToState = To;
+	using ConditionType = Condition;
+};
+
+// Transitions of the same state are checked in the order they are listed, which is their order of importance
+template<typename... Transitions>
+struct StaticTransitionTable {};
+
+// The first state is the start state, every state has to appear only once
+template<typename Table, typename StartState, typename... OtherStates>
+class StaticFiniteStateMachine;
+
+template<typename... Transitions, typename StartState, typename... OtherStates>
+class StaticFiniteStateMachine<StaticTransitionTable<Transitions...>, StartState, OtherStates...> final : public DecisionMaking
+{
+public:
+	StaticFiniteStateMachine(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard)
+		: m_CurrentState(&std::get<StartState>(m_States)),
+		m_pBlackboard(pBlackboard)
+	{
+		std::get<StartState>(m_States).OnEnter(pInterface, pPlanner, m_pBlackboard);
+	}
+	virtual ~StaticFiniteStateMachine() = default;
+
+	StaticFiniteStateMachine(const StaticFiniteStateMachine&) = delete;
+	StaticFiniteStateMachine& operator=(const StaticFiniteStateMachine&) = delete;
+
+	virtual void Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, float deltaT) override
+	{
+		// Same event handling as the runtime FiniteStateMachine
+		FSMEventMask pendingEvents = m_EventDriven ? pPlanner->ConsumeEvents() : FSMEvent::ALL;
+
+		if (pendingEvents != FSMEvent::NONE)
+		{
+			std::visit([&](auto* pState)
+				{
+					using State = std::remove_pointer_t<decltype(pState)>;
+					// Short circuits on the first transition that is taken
+					(void)(TryTransition<State, Transitions>(pInterface, pPlanner, pendingEvents) || ...);
+				}, m_CurrentState);
+		}
+
+		std::visit([&](auto* pState) { pState->Update(pInterface, pPlanner, m_pBlackboard, deltaT); }, m_CurrentState);
+	}
+
+	void SetEventDriven(bool eventDriven) { m_EventDriven = eventDriven; };
+	bool IsEventDriven() const { return m_EventDriven; };
+
+	template<typename State>
+	bool IsInState() const { return std::holds_alternative<State*>(m_CurrentState); };
+private:
+	std::tuple<StartState, OtherStates...> m_States{};
+	std::variant<StartState*, OtherStates*...> m_CurrentState;
+	Blackboard* m_pBlackboard = nullptr; // Not owned
+	bool m_EventDriven = false;
+
+	template<typename State, typename Transition>
+	bool TryTransition(IExamInterface* pInterface, GOAPPlanner* pPlanner, FSMEventMask pendingEvents)
+	{
+		if constexpr (std::is_same_v<typename Transition::FromState, State>)
+		{
+			const typename Transition::ConditionType condition{};
+			if ((condition.GetTriggerEvents() & pendingEvents) == 0)
+				return false;
+
+			if (condition.ToTransition(pInterface, pPlanner, m_pBlackboard))
+			{
+				SetState<State, typename Transition::ToState>(pInterface, pPlanner);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename From, typename To>
+	void SetState(IExamInterface* pInterface, GOAPPlanner* pPlanner)
+	{
+		std::get<From>(m_States).OnExit(pInterface, pPlanner, m_pBlackboard);
+		m_CurrentState = &std::get<To>(m_States);
+
+		if (DebugOutputManager::GetInstance()->IsDebugTypeEnabled(DebugOutputManager::DebugType::FSM_STATE))
+		{
+			std::string stateClassName = typeid(To).name();
+			DebugOutputManager::GetInstance()->DebugLine("Entering state: " + stateClassName + "\n",
+				DebugOutputManager::DebugType::FSM_STATE);
+		}
+		std::get<To>(m_States).OnEnter(pInterface, pPlanner, m_pBlackboard);
+	}
+};
@@ -3,10 +3,13 @@
 //Includes
 #include "SteeringBehaviors.h"
 #include "Blackboard.h"
+#include "BlackboardKeys.h"
 #include "Agent.h"
 #include "IExamInterface.h"
 #include "ConfigManager.h"
 #include "utils.h"
+#include "TickScheduler.h"
+#include "CachedExamInterface.h"
 
 //SEEK (base>ISteeringBehavior)
 SteeringPlugin_Output Seek::CalculateSteering(IExamInterface* pInterface, float deltaT, AgentInfo& agentInfo, Blackboard* pBlackboard, bool changeGoal)
@@ -41,22 +44,25 @@ SteeringPlugin_Output SeekAndDodge::CalculateSteering(IExamInterface* pInterface
 	Agent* pAgent = nullptr;
 	WorldState* pWorldState = nullptr;
 	Elite::Vector2* lastSeenEnemyPos{};
+	TickScheduler* pScheduler = nullptr;
+	CachedExamInterface* pInterfaceCache = nullptr;
 
 	// Check if agent data is valid
-	bool dataValid = pBlackboard->GetData("Agent", pAgent)
-		&& pBlackboard->GetData("LastEnemyPos", lastSeenEnemyPos)
-		&& pBlackboard->GetData("WorldState", pWorldState);
+	bool dataValid = pBlackboard->GetData(BlackboardKeys::AGENT, pAgent)
+		&& pBlackboard->GetData(BlackboardKeys::LAST_ENEMY_POS, lastSeenEnemyPos)
+		&& pBlackboard->GetData(BlackboardKeys::WORLD_STATE, pWorldState)
+		&& pBlackboard->GetData(BlackboardKeys::TICK_SCHEDULER, pScheduler)
+		&& pBlackboard->GetData(BlackboardKeys::INTERFACE_CACHE, pInterfaceCache);
 	if (!dataValid) return steering;
 
 	// Recalculate goal pos due to all the navmesh bugs
-	if (m_NavMeshRefreshTimer > m_NavMeshRefreshTime)
+	if (pScheduler->TryRun(ScheduledTask::NAVMESH_REFRESH))
 	{
 		DebugOutputManager::GetInstance()->DebugLine("Asking new route towards goal...\n",
 			DebugOutputManager::DebugType::STEERING);
-		pAgent->SetGoalPosition(pInterface->NavMesh_GetClosestPathPoint(pAgent->GetDistantGoalPosition()));
-		m_NavMeshRefreshTimer = 0.f;
+		ScopedTaskCost taskCost{ pScheduler, ScheduledTask::NAVMESH_REFRESH };
+		pAgent->SetGoalPosition(pInterfaceCache->NavMesh_GetClosestPathPoint(pAgent->GetDistantGoalPosition()));
 	}
-	m_NavMeshRefreshTimer += deltaT;
 
 	bool enemyInSight = false;
 	if (!pWorldState->GetState("EnemyInSight", enemyInSight))
@@ -79,7 +85,7 @@ SteeringPlugin_Output SeekAndDodge::CalculateSteering(IExamInterface* pInterface
 	if (enemyInSight)
 	{
 		int* enemyCount = nullptr;
-		pBlackboard->GetData("EnemyCount", enemyCount);
+		pBlackboard->GetData(BlackboardKeys::ENEMY_COUNT, enemyCount);
 		float dodgeRange{ 10.f };
 		if (*enemyCount > 1)
 		{
@@ -114,7 +120,7 @@ SteeringPlugin_Output SeekAndDodge::CalculateSteering(IExamInterface* pInterface
 			// Set a new goal position that dodges the enemy
 			float halfPi = float(M_PI) / 2.f;
 			Elite::Vector2 newGoal = agentInfo.Position + Elite::Vector2{ cos(orientationAngleRad + -angleToEnemy) * dodgeRange, sin(orientationAngleRad + -angleToEnemy) * dodgeRange };
-			pAgent->SetGoalPosition(pInterface->NavMesh_GetClosestPathPoint(newGoal));
+			pAgent->SetGoalPosition(pInterfaceCache->NavMesh_GetClosestPathPoint(newGoal));
 			steering.RunMode = true;
 		}
 	}
@@ -162,12 +168,12 @@ SteeringPlugin_Output SeekAndDodge::CalculateSteering(IExamInterface* pInterface
 	else
 	{
 		// Use stamina when we have enough
-		if (pInterface->Agent_GetInfo().Stamina > 9.f)
+		if (agentInfo.Stamina > 9.f)
 			steering.RunMode = true;
 	}
 
 	bool isInPurgeZone{ false };
-	if (pBlackboard->GetData("AgentInPurgeZone", isInPurgeZone))
+	if (pBlackboard->GetData(BlackboardKeys::AGENT_IN_PURGE_ZONE, isInPurgeZone))
 	{
 		if (isInPurgeZone)
 			steering.RunMode = true;
@@ -199,10 +205,10 @@ SteeringPlugin_Output KillBehavior::CalculateSteering(IExamInterface* pInterface
 	//float goalAngleRad = goalAngle * float(M_PI) / 180.f;
 
 	WorldState* pWorldState = nullptr;
-	if (pBlackboard->GetData("WorldState", pWorldState))
+	if (pBlackboard->GetData(BlackboardKeys::WORLD_STATE, pWorldState))
 	{
 		Elite::Vector2* lastSeenEnemyPos{};
-		pBlackboard->GetData("LastEnemyPos", lastSeenEnemyPos);
+		pBlackboard->GetData(BlackboardKeys::LAST_ENEMY_POS, lastSeenEnemyPos);
 
 		if (ConfigManager::GetInstance()->GetDebugLastEnemyLocation())
 			pInterface->Draw_Circle(*lastSeenEnemyPos, 1.5f, { 1.f,1.f,1.f });
@@ -224,7 +230,7 @@ SteeringPlugin_Output KillBehavior::CalculateSteering(IExamInterface* pInterface
 				steering.AngularVelocity = 0.f;
 
 				Agent* pAgent = nullptr;
-				bool isValid = pBlackboard->GetData("Agent", pAgent);
+				bool isValid = pBlackboard->GetData(BlackboardKeys::AGENT, pAgent);
 				if (pAgent)
 				{
 					pAgent->Shoot();
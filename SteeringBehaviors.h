@@ -62,8 +62,6 @@ protected:
 	float m_LastOrientationAngle{};
 private:
 	float m_DodgeAngle = 35.f; // Angle in degrees
-	float m_NavMeshRefreshTime{ 1.f };
-	float m_NavMeshRefreshTimer{ 1.f };
 };
 
 class KillBehavior : public SeekAndDodge
@@ -76,6 +74,4 @@ public:
 	SteeringPlugin_Output CalculateSteering(IExamInterface * pInterface, float deltaT, AgentInfo & agentInfo, Blackboard * pBlackboard, bool changeGoal = false) override;
 private:
 	float m_DodgeAngle = 35.f; // Angle in degrees
-	float m_NavMeshRefreshTime{ 1.f };
-	float m_NavMeshRefreshTimer{ 1.f };
 };
\ No newline at end of file
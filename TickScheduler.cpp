@@ -0,0 +1,140 @@
+#include "stdafx.h"
+#include "TickScheduler.h"
+#include "ConfigManager.h"
+#include "DebugOutputManager.h"
+
+void TickScheduler::RegisterTask(ScheduledTask task, float interval, float phase, bool expensive)
+{
+	TaskData& taskData = m_Tasks[static_cast<int>(task)];
+	taskData.interval = interval;
+	taskData.timer = -phase;
+	taskData.expensive = expensive;
+}
+
+void TickScheduler::BeginFrame(float deltaTime)
+{
+	m_ExpensiveTaskRan = false;
+	for (TaskData& taskData : m_Tasks)
+	{
+		taskData.timer += deltaTime;
+	}
+
+	float reportInterval = ConfigManager::GetInstance()->GetSchedulerReportInterval();
+	m_ReportTimer += deltaTime;
+	if (reportInterval > 0.f && m_ReportTimer >= reportInterval)
+	{
+		Report();
+		m_ReportTimer = 0.f;
+	}
+}
+
+bool TickScheduler::TryRun(ScheduledTask task)
+{
+	TaskData& taskData = m_Tasks[static_cast<int>(task)];
+	if (taskData.timer < taskData.interval * taskData.intervalScale)
+		return false;
+
+	// Stagger expensive work, the task stays due and runs on the next frame without expensive work
+	if (taskData.expensive)
+	{
+		if (m_ExpensiveTaskRan)
+		{
+			++taskData.deferrals;
+			return false;
+		}
+		m_ExpensiveTaskRan = true;
+	}
+
+	taskData.timer = 0.f;
+	++taskData.runs;
+	return true;
+}
+
+void TickScheduler::Trigger(ScheduledTask task)
+{
+	TaskData& taskData = m_Tasks[static_cast<int>(task)];
+	float interval = taskData.interval * taskData.intervalScale;
+	if (taskData.timer < interval)
+		taskData.timer = interval;
+}
+
+void TickScheduler::AddCost(ScheduledTask task, float milliseconds)
+{
+	TaskData& taskData = m_Tasks[static_cast<int>(task)];
+	taskData.totalCost += milliseconds;
+	taskData.maxCost = std::max(taskData.maxCost, milliseconds);
+}
+
+void TickScheduler::SetIntervalScale(ScheduledTask task, float scale)
+{
+	m_Tasks[static_cast<int>(task)].intervalScale = scale;
+}
+
+float TickScheduler::GetInterval(ScheduledTask task) const
+{
+	const TaskData& taskData = m_Tasks[static_cast<int>(task)];
+	return taskData.interval * taskData.intervalScale;
+}
+
+const char* TickScheduler::GetTaskName(ScheduledTask task) const
+{
+	switch (task)
+	{
+	case ScheduledTask::PLANNER:
+		return "Planner";
+	case ScheduledTask::PATH_REFRESH:
+		return "PathRefresh";
+	case ScheduledTask::NAVMESH_REFRESH:
+		return "NavMeshRefresh";
+	case ScheduledTask::SEEK_LOCATION:
+		return "SeekLocation";
+	case ScheduledTask::FAST_SCOUT:
+		return "FastScout";
+	default:
+		return "Unknown";
+	}
+}
+
+void TickScheduler::Report()
+{
+	bool debug = DebugOutputManager::GetInstance()->IsDebugTypeEnabled(DebugOutputManager::DebugType::SCHEDULER);
+	for (int i{ 0 }; i < static_cast<int>(ScheduledTask::COUNT); ++i)
+	{
+		TaskData& taskData = m_Tasks[i];
+		if (debug)
+		{
+			float actualRate = taskData.runs / m_ReportTimer;
+			float interval = taskData.interval * taskData.intervalScale;
+			float targetRate = interval > 0.f ? 1.f / interval : 0.f;
+			float averageCost = taskData.runs > 0 ? taskData.totalCost / taskData.runs : 0.f;
+
+			char line[256];
+			snprintf(line, sizeof(line), "%-15s %6.2f Hz (target %6.2f Hz), avg %.3f ms, max %.3f ms, deferred %u\n",
+				GetTaskName(static_cast<ScheduledTask>(i)), actualRate, targetRate, averageCost, taskData.maxCost, taskData.deferrals);
+			DebugOutputManager::GetInstance()->DebugLine(line, DebugOutputManager::DebugType::SCHEDULER);
+		}
+
+		taskData.runs = 0;
+		taskData.deferrals = 0;
+		taskData.totalCost = 0.f;
+		taskData.maxCost = 0.f;
+	}
+}
+
+// ---------------------------
+// ScopedTaskCost
+ScopedTaskCost::ScopedTaskCost(TickScheduler* pScheduler, ScheduledTask task) :
+	m_pScheduler(pScheduler),
+	m_Task(task),
+	m_Start(std::chrono::high_resolution_clock::now())
+{
+}
+
+ScopedTaskCost::~ScopedTaskCost()
+{
+	if (!m_pScheduler)
+		return;
+
+	std::chrono::duration<float, std::milli> cost = std::chrono::high_resolution_clock::now() - m_Start;
+	m_pScheduler->AddCost(m_Task, cost.count());
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <chrono>
+
+// Every periodic task of the agent, rates are set from ConfigManager when the agent registers them
+enum class ScheduledTask
+{
+	PLANNER,
+	PATH_REFRESH,
+	NAVMESH_REFRESH,
+	SEEK_LOCATION,
+	FAST_SCOUT,
+	COUNT
+};
+
+// Central scheduler for the agent's periodic work. Every task runs at its own interval, offset by a phase
+// Only one expensive task runs per frame, others that are due wait for the next free frame
+class TickScheduler final
+{
+public:
+	TickScheduler() = default;
+
+	// Phase delays the first run so tasks with the same interval don't line up
+	void RegisterTask(ScheduledTask task, float interval, float phase, bool expensive);
+	void BeginFrame(float deltaTime);
+
+	// Returns true if the task is due and allowed to run this frame, counts as a run
+	bool TryRun(ScheduledTask task);
+	// Makes the task due on its next TryRun, for callers that need a fresh result right away
+	void Trigger(ScheduledTask task);
+	void AddCost(ScheduledTask task, float milliseconds);
+	// Multiplies the registered interval, used to lower rates under load
+	void SetIntervalScale(ScheduledTask task, float scale);
+
+	float GetInterval(ScheduledTask task) const;
+	const char* GetTaskName(ScheduledTask task) const;
+private:
+	struct TaskData
+	{
+		float interval{ 1.f };
+		float intervalScale{ 1.f };
+		float timer{ 0.f }; // Time since the last run, due once it reaches the interval
+		bool expensive{ false };
+
+		// Stats since the last report
+		uint32_t runs{ 0 };
+		uint32_t deferrals{ 0 };
+		float totalCost{ 0.f };
+		float maxCost{ 0.f };
+	};
+
+	TaskData m_Tasks[static_cast<int>(ScheduledTask::COUNT)]{};
+	bool m_ExpensiveTaskRan{ false };
+
+	float m_ReportTimer{ 0.f };
+
+	void Report();
+};
+
+// Adds the time between construction and destruction to the cost of a task
+class ScopedTaskCost final
+{
+public:
+	ScopedTaskCost(TickScheduler* pScheduler, ScheduledTask task);
+	~ScopedTaskCost();
+	ScopedTaskCost(const ScopedTaskCost&) = delete;
+	ScopedTaskCost& operator=(const ScopedTaskCost&) = delete;
+private:
+	TickScheduler* m_pScheduler;
+	ScheduledTask m_Task;
+	std::chrono::high_resolution_clock::time_point m_Start;
+};
@@ -0,0 +1,131 @@
+// BlackboardStressTest: checks that Blackboard::ReadPublished never returns a torn read
+// Usage: BlackboardStressTest [publishes]
+// Build standalone with threads enabled, it only depends on the standard library and Blackboard.h
+// One writer changes and publishes two entries that always hold the same generation, four readers read them
+// concurrently and check that every field of both entries agrees and that the generation never goes back
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../Blackboard.h"
+
+// Large enough that a copy interrupted by a publish shows up as mixed generations
+struct Payload
+{
+	uint32_t generation[16];
+
+	bool operator==(const Payload& other) const
+	{
+		for (size_t i{ 0 }; i < 16; ++i)
+		{
+			if (generation[i] != other.generation[i])
+				return false;
+		}
+		return true;
+	}
+};
+
+const BlackboardKey<Payload> PAYLOAD{ 0, "Payload" };
+const BlackboardKey<uint32_t> GENERATION{ 1, "Generation" };
+
+const int ReaderCount{ 4 };
+
+struct ReaderResult
+{
+	uint64_t reads{ 0 };
+	uint64_t attempts{ 0 };
+	uint64_t tornReads{ 0 };
+	uint64_t backwardReads{ 0 };
+};
+
+Payload MakePayload(uint32_t generation)
+{
+	Payload payload{};
+	for (uint32_t& value : payload.generation)
+	{
+		value = generation;
+	}
+	return payload;
+}
+
+void Read(const Blackboard& blackboard, const std::atomic<bool>& isDone, ReaderResult& result)
+{
+	uint32_t lastGeneration{ 0 };
+	while (!isDone.load(std::memory_order_relaxed))
+	{
+		Payload payload{};
+		uint32_t generation{ 0 };
+		blackboard.ReadPublished([&payload, &generation, &result](const Blackboard::PublishedView& view)
+			{
+				++result.attempts;
+				view.GetData(PAYLOAD, payload);
+				view.GetData(GENERATION, generation);
+			});
+		++result.reads;
+
+		bool isTorn = generation != payload.generation[0];
+		for (uint32_t value : payload.generation)
+		{
+			isTorn |= value != generation;
+		}
+		if (isTorn)
+			++result.tornReads;
+		if (generation < lastGeneration)
+			++result.backwardReads;
+		lastGeneration = generation;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t publishCount = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 2000000;
+
+	Blackboard blackboard{ true };
+	blackboard.AddData(PAYLOAD, MakePayload(0));
+	blackboard.AddData(GENERATION, 0u);
+	blackboard.Publish();
+
+	std::atomic<bool> isDone{ false };
+	std::vector<ReaderResult> results(ReaderCount);
+	std::vector<std::thread> readers{};
+	for (int i{ 0 }; i < ReaderCount; ++i)
+	{
+		readers.emplace_back(Read, std::cref(blackboard), std::cref(isDone), std::ref(results[i]));
+	}
+
+	// The owning thread, the same steps the agent takes every frame
+	for (uint32_t generation{ 1 }; generation <= publishCount; ++generation)
+	{
+		blackboard.ChangeData(PAYLOAD, MakePayload(generation));
+		blackboard.ChangeData(GENERATION, generation);
+		blackboard.Publish();
+	}
+
+	isDone.store(true, std::memory_order_relaxed);
+	for (std::thread& reader : readers)
+	{
+		reader.join();
+	}
+
+	ReaderResult total{};
+	for (int i{ 0 }; i < ReaderCount; ++i)
+	{
+		printf("Reader %d: %llu reads, %llu attempts, %llu torn, %llu backwards\n", i,
+			static_cast<unsigned long long>(results[i].reads), static_cast<unsigned long long>(results[i].attempts),
+			static_cast<unsigned long long>(results[i].tornReads), static_cast<unsigned long long>(results[i].backwardReads));
+		total.reads += results[i].reads;
+		total.attempts += results[i].attempts;
+		total.tornReads += results[i].tornReads;
+		total.backwardReads += results[i].backwardReads;
+	}
+
+	printf("%u publishes, %llu reads, %llu retries, %llu torn, %llu backwards\n", publishCount,
+		static_cast<unsigned long long>(total.reads), static_cast<unsigned long long>(total.attempts - total.reads),
+		static_cast<unsigned long long>(total.tornReads), static_cast<unsigned long long>(total.backwardReads));
+
+	bool isPassed = total.tornReads == 0 && total.backwardReads == 0;
+	printf(isPassed ? "PASSED\n" : "FAILED\n");
+	return isPassed ? 0 : 1;
+}
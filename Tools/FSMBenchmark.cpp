@@ -0,0 +1,153 @@
+// FSMBenchmark: measures the transition dispatch of FiniteStateMachine::Update and StaticFiniteStateMachine::Update
+// Usage: FSMBenchmark [updates]
+// Build with FSMState.cpp and DebugOutputManager.cpp from the plugin, optimized
+// Every state has the same amount of transitions that never fire, so each update checks all of them like the agent does
+// between state changes. The map based dispatch FiniteStateMachine used before is kept below as the reference
+// All three machines are wired up with the same states and transitions
+#include "../stdafx.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include <tuple>
+#include "../FSMState.h"
+#include "../StaticFSM.h"
+#include "../GOAPPlanner.h"
+
+const int StateCount{ 6 };
+const int TransitionsPerState{ 4 };
+const int RunCount{ 5 };
+
+// Read by every transition, so the checks can't be folded away
+volatile bool g_TakeTransitions{ false };
+int g_StateUpdates{ 0 };
+
+// The benchmark doesn't run event driven, this only keeps the planner out of the build
+FSMEventMask GOAPPlanner::ConsumeEvents()
+{
+	return FSMEvent::ALL;
+}
+
+// A type per state, the static machine tells its states apart by type
+template<int Id>
+class BenchmarkState final : public FSMState
+{
+public:
+	void Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard, float deltaTime) override { ++g_StateUpdates; };
+};
+
+class BenchmarkTransition final : public FSMTransition
+{
+public:
+	bool ToTransition(IExamInterface* pInterface, GOAPPlanner* pPlanner, Blackboard* pBlackboard) const override { return g_TakeTransitions; };
+};
+
+// FiniteStateMachine::Update before the transitions were flattened into one table
+class MapDispatchFSM final : public DecisionMaking
+{
+public:
+	explicit MapDispatchFSM(FSMState* startState) : m_pCurrentState(startState)
+	{}
+
+	void AddTransition(FSMState* startState, FSMState* toState, FSMTransition* transition)
+	{
+		m_Transitions[startState].push_back(std::make_pair(transition, toState));
+	}
+
+	void Update(IExamInterface* pInterface, GOAPPlanner* pPlanner, float deltaTime) override
+	{
+		auto it = m_Transitions.find(m_pCurrentState);
+		if (it != m_Transitions.end())
+		{
+			for (TransitionStatePair& transPair : it->second)
+			{
+				if (transPair.first->ToTransition(pInterface, pPlanner, nullptr))
+				{
+					m_pCurrentState = transPair.second;
+					break;
+				}
+			}
+		}
+
+		if (m_pCurrentState)
+			m_pCurrentState->Update(pInterface, pPlanner, nullptr, deltaTime);
+	}
+
+	void SetState(FSMState* pState) { m_pCurrentState = pState; };
+private:
+	typedef std::pair<FSMTransition*, FSMState*> TransitionStatePair;
+	std::map<FSMState*, std::vector<TransitionStatePair>> m_Transitions;
+	FSMState* m_pCurrentState;
+};
+
+// Every state moves on to the next one, in a ring
+template<int Id>
+using RingTransition = StaticTransition<BenchmarkState<Id>, BenchmarkState<(Id + 1) % StateCount>, BenchmarkTransition>;
+
+// Starts in the last state, like the runtime machines below
+using BenchmarkStaticFSM = StaticFiniteStateMachine<
+	StaticTransitionTable<
+		RingTransition<0>, RingTransition<0>, RingTransition<0>, RingTransition<0>,
+		RingTransition<1>, RingTransition<1>, RingTransition<1>, RingTransition<1>,
+		RingTransition<2>, RingTransition<2>, RingTransition<2>, RingTransition<2>,
+		RingTransition<3>, RingTransition<3>, RingTransition<3>, RingTransition<3>,
+		RingTransition<4>, RingTransition<4>, RingTransition<4>, RingTransition<4>,
+		RingTransition<5>, RingTransition<5>, RingTransition<5>, RingTransition<5>>,
+	BenchmarkState<5>, BenchmarkState<0>, BenchmarkState<1>, BenchmarkState<2>, BenchmarkState<3>, BenchmarkState<4>>;
+static_assert(StateCount == 6 && TransitionsPerState == 4, "BenchmarkStaticFSM lists the transitions by hand");
+
+// Nanoseconds per update, through the DecisionMaking interface like Agent calls it
+double Measure(DecisionMaking* pDecisionMaking, long updateCount)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (long i{ 0 }; i < updateCount; ++i)
+	{
+		pDecisionMaking->Update(nullptr, nullptr, 0.f);
+	}
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / updateCount;
+}
+
+int main(int argc, char* argv[])
+{
+	long updateCount = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 20000000;
+
+	std::tuple<BenchmarkState<0>, BenchmarkState<1>, BenchmarkState<2>, BenchmarkState<3>, BenchmarkState<4>, BenchmarkState<5>> stateStorage{};
+	FSMState* states[StateCount]{ &std::get<0>(stateStorage), &std::get<1>(stateStorage), &std::get<2>(stateStorage),
+		&std::get<3>(stateStorage), &std::get<4>(stateStorage), &std::get<5>(stateStorage) };
+	std::vector<BenchmarkTransition> transitions(StateCount * TransitionsPerState);
+
+	// The last state has the most states and transitions wired up before it
+	FSMState* pMeasuredState = states[StateCount - 1];
+	MapDispatchFSM mapFSM{ pMeasuredState };
+	FiniteStateMachine tableFSM{ pMeasuredState, nullptr, nullptr, nullptr };
+	for (int state{ 0 }; state < StateCount; ++state)
+	{
+		for (int transition{ 0 }; transition < TransitionsPerState; ++transition)
+		{
+			BenchmarkTransition* pTransition = &transitions[state * TransitionsPerState + transition];
+			mapFSM.AddTransition(states[state], states[(state + 1) % StateCount], pTransition);
+			tableFSM.AddTransition(states[state], states[(state + 1) % StateCount], pTransition);
+		}
+	}
+	BenchmarkStaticFSM staticFSM{ nullptr, nullptr, nullptr };
+
+	// Interleaved runs, the fastest one is the least disturbed by the rest of the machine
+	double mapTime{ 1e9 };
+	double tableTime{ 1e9 };
+	double staticTime{ 1e9 };
+	for (int run{ 0 }; run < RunCount; ++run)
+	{
+		mapTime = std::min(mapTime, Measure(&mapFSM, updateCount));
+		tableTime = std::min(tableTime, Measure(&tableFSM, updateCount));
+		staticTime = std::min(staticTime, Measure(&staticFSM, updateCount));
+	}
+
+	printf("%d states, %d transitions each, best of %d runs of %ld updates\n", StateCount, TransitionsPerState, RunCount, updateCount);
+	printf("Map dispatch:   %.2f ns per update\n", mapTime);
+	printf("Table dispatch: %.2f ns per update\n", tableTime);
+	printf("Static FSM:     %.2f ns per update\n", staticTime);
+	return g_StateUpdates == 3 * RunCount * updateCount && staticFSM.IsInState<BenchmarkState<5>>() ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+// HouseBoundsBenchmark: checks the SSE house tests of HouseBoundsTable against the scalar reference and times them
+// Usage: HouseBoundsBenchmark [seed]
+// Build with HouseBoundsTable.cpp, PositionQuantizer.cpp and utils.cpp from the plugin, optimized, plus what utils.cpp links
+// against (WorldState.cpp, WorldStateHistory.cpp and DebugOutputManager.cpp)
+// Houses are random and can overlap, so where any containing house is a valid answer it is checked with utils::IsPointInRect
+#include "../stdafx.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../HouseBoundsTable.h"
+#include "../utils.h"
+
+struct House
+{
+	Elite::Vector2 center;
+	Elite::Vector2 size;
+};
+
+struct Scene
+{
+	std::vector<House> houses{};
+	HouseBoundsTable table{};
+	std::vector<Elite::Vector2> points{}; // Random, a third of them inside a house
+	std::vector<Elite::Vector2> path{}; // An agent walking through the houses, many frames per house
+};
+
+// Keeps the results alive so the timed loops aren't optimized away
+volatile long long g_Sink{ 0 };
+
+template<typename Func>
+double MeasurePerQuery(size_t queryCount, Func func)
+{
+	const int repetitions{ 20 };
+	auto start = std::chrono::steady_clock::now();
+	for (int i{ 0 }; i < repetitions; ++i)
+	{
+		func();
+	}
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count() / (repetitions * queryCount);
+}
+
+Scene CreateScene(std::mt19937& random, int houseCount)
+{
+	std::uniform_real_distribution<float> position{ -250.f, 250.f };
+	std::uniform_real_distribution<float> size{ 10.f, 30.f };
+	std::uniform_real_distribution<float> offset{ -.6f, .6f };
+
+	Scene scene{};
+	for (int i{ 0 }; i < houseCount; ++i)
+	{
+		House house{ Elite::Vector2{ position(random), position(random) }, Elite::Vector2{ size(random), size(random) } };
+		scene.houses.push_back(house);
+		scene.table.Set(static_cast<uint32_t>(i), house.center, house.size);
+	}
+
+	for (int i{ 0 }; i < 30000; ++i)
+	{
+		if (i % 3 == 0)
+		{
+			const House& house = scene.houses[random() % scene.houses.size()];
+			scene.points.push_back(Elite::Vector2{ house.center.x + offset(random) * house.size.x, house.center.y + offset(random) * house.size.y });
+		}
+		else
+			scene.points.push_back(Elite::Vector2{ position(random), position(random) });
+	}
+
+	for (int i{ 0 }; i < 64; ++i)
+	{
+		const House& house = scene.houses[i % scene.houses.size()];
+		for (int frame{ 0 }; frame < 200; ++frame)
+		{
+			scene.path.push_back(Elite::Vector2{ house.center.x + house.size.x * (-.7f + 1.4f * frame / 200.f), house.center.y });
+		}
+	}
+	return scene;
+}
+
+// Without a hint the kernels return the first house like the reference, with a hint any house containing the point
+int CountMismatches(const Scene& scene)
+{
+	int mismatches{ 0 };
+	auto isValidHit = [&scene](int house, int reference, const Elite::Vector2& point, float margin)
+	{
+		if (house < 0 || reference < 0)
+			return house == reference;
+		return utils::IsPointInRect(point, scene.houses[house].center, scene.houses[house].size, margin);
+	};
+
+	std::vector<int> batchHouses{};
+	for (float margin : { 1.f, 0.f, -3.f })
+	{
+		scene.table.FindContaining(scene.points, margin, batchHouses);
+		for (size_t i{ 0 }; i < scene.points.size(); ++i)
+		{
+			int reference = scene.table.FindContainingScalar(scene.points[i], margin);
+			if (scene.table.FindContaining(scene.points[i], margin) != reference)
+				++mismatches;
+			if (batchHouses[i] != reference)
+				++mismatches;
+			// The reference itself has to agree with utils::IsPointInRect
+			if (!isValidHit(reference, reference, scene.points[i], margin))
+				++mismatches;
+		}
+	}
+
+	int hint{ -1 };
+	for (const Elite::Vector2& point : scene.path)
+	{
+		int house = scene.table.FindContaining(point, 1.f, hint);
+		if (!isValidHit(house, scene.table.FindContainingScalar(point, 1.f), point, 1.f))
+			++mismatches;
+		hint = house;
+	}
+	return mismatches;
+}
+
+bool RunHouseQueries(std::mt19937& random, int houseCount)
+{
+	Scene scene = CreateScene(random, houseCount);
+	int mismatches = CountMismatches(scene);
+
+	const HouseBoundsTable& table = scene.table;
+	double scalarTime = MeasurePerQuery(scene.points.size(), [&]()
+		{
+			for (const Elite::Vector2& point : scene.points)
+				g_Sink += table.FindContainingScalar(point, 1.f);
+		});
+	double simdTime = MeasurePerQuery(scene.points.size(), [&]()
+		{
+			for (const Elite::Vector2& point : scene.points)
+				g_Sink += table.FindContaining(point, 1.f);
+		});
+	double pathScalarTime = MeasurePerQuery(scene.path.size(), [&]()
+		{
+			for (const Elite::Vector2& point : scene.path)
+				g_Sink += table.FindContainingScalar(point, 1.f);
+		});
+	double pathHintTime = MeasurePerQuery(scene.path.size(), [&]()
+		{
+			int hint{ -1 };
+			for (const Elite::Vector2& point : scene.path)
+			{
+				hint = table.FindContaining(point, 1.f, hint);
+				g_Sink += hint;
+			}
+		});
+	double batchScalarTime = MeasurePerQuery(scene.points.size(), [&]()
+		{
+			for (const Elite::Vector2& point : scene.points)
+				g_Sink += table.FindContainingScalar(point, -3.f);
+		});
+	std::vector<int> batchHouses{};
+	double batchTime = MeasurePerQuery(scene.points.size(), [&]()
+		{
+			table.FindContaining(scene.points, -3.f, batchHouses);
+			g_Sink += batchHouses.front();
+		});
+
+	printf("%d houses: %d mismatches\n", houseCount, mismatches);
+	printf("  Random points: scalar %.1f ns, SSE %.1f ns per query\n", scalarTime, simdTime);
+	printf("  Agent path:    scalar %.1f ns, SSE with hint %.1f ns per query\n", pathScalarTime, pathHintTime);
+	printf("  Scout batch:   scalar %.1f ns, SSE batch %.1f ns per point\n", batchScalarTime, batchTime);
+	return mismatches == 0;
+}
+
+// RemoveCornersNearHouse, the remembered corners against one new house
+bool RunCornerQueries(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> position{ -250.f, 250.f };
+	std::uniform_real_distribution<float> size{ 30.f, 90.f };
+	const float margin{ -5.f };
+
+	PositionQuantizer quantizer{ Elite::Vector2{}, Elite::Vector2{ 500.f, 500.f } };
+	std::vector<QuantizedPosition> corners{};
+	for (int i{ 0 }; i < 128; ++i)
+	{
+		corners.push_back(quantizer.Encode(Elite::Vector2{ position(random), position(random) }));
+	}
+	std::vector<House> houses{};
+	for (int i{ 0 }; i < 1000; ++i)
+	{
+		houses.push_back(House{ Elite::Vector2{ position(random), position(random) }, Elite::Vector2{ size(random), size(random) } });
+	}
+
+	std::vector<uint32_t> indices{};
+	std::vector<uint32_t> referenceIndices{};
+	auto findReference = [&](const House& house)
+	{
+		referenceIndices.clear();
+		for (uint32_t i{ 0 }; i < corners.size(); ++i)
+		{
+			if (utils::IsPointInRect(quantizer.Decode(corners[i]), house.center, house.size, margin))
+				referenceIndices.push_back(i);
+		}
+	};
+
+	int mismatches{ 0 };
+	for (const House& house : houses)
+	{
+		indices.clear();
+		HouseBoundsTable::FindPointsInHouse(corners, quantizer, house.center, house.size, margin, indices);
+		findReference(house);
+		if (indices != referenceIndices)
+			++mismatches;
+	}
+
+	double scalarTime = MeasurePerQuery(houses.size(), [&]()
+		{
+			for (const House& house : houses)
+			{
+				findReference(house);
+				g_Sink += referenceIndices.size();
+			}
+		});
+	double simdTime = MeasurePerQuery(houses.size(), [&]()
+		{
+			for (const House& house : houses)
+			{
+				indices.clear();
+				HouseBoundsTable::FindPointsInHouse(corners, quantizer, house.center, house.size, margin, indices);
+				g_Sink += indices.size();
+			}
+		});
+
+	printf("Corner removal, %zu corners: %d mismatches, scalar %.1f ns, SSE %.1f ns per house\n", corners.size(), mismatches, scalarTime, simdTime);
+	return mismatches == 0;
+}
+
+int main(int argc, char* argv[])
+{
+	std::mt19937 random{ argc > 1 ? static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10)) : 7u };
+
+	bool isPassed{ true };
+	for (int houseCount : { 16, 64 })
+	{
+		isPassed &= RunHouseQueries(random, houseCount);
+	}
+	isPassed &= RunCornerQueries(random);
+
+	printf(isPassed ? "PASSED\n" : "FAILED\n");
+	return isPassed ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// WorldStateHistoryReader: offline tool that rebuilds the worldstate timeline from a history dump
+// Usage: WorldStateHistoryReader <WorldStateHistory.bin> [--timeline]
+// Build standalone, it only depends on the standard library and WorldStateHistory.h
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "../WorldStateHistory.h"
+
+using namespace WorldStateHistoryFormat;
+
+struct HistoryDump
+{
+	Header header{};
+	std::vector<std::string> stateNames{};
+	std::vector<bool> currentValues{};
+	std::vector<Record> records{};
+};
+
+bool LoadDump(const char* filePath, HistoryDump& dump)
+{
+	std::ifstream file{ filePath, std::ios::binary };
+	if (!file)
+		return false;
+
+	file.read(reinterpret_cast<char*>(&dump.header), sizeof(Header));
+	if (!file || dump.header.magic != Magic || dump.header.version != Version)
+		return false;
+
+	dump.stateNames.resize(dump.header.stateCount);
+	for (std::string& name : dump.stateNames)
+	{
+		uint16_t length{ 0 };
+		file.read(reinterpret_cast<char*>(&length), sizeof(length));
+		name.resize(length);
+		file.read(&name[0], length);
+	}
+
+	dump.currentValues.resize(dump.header.stateCount);
+	for (size_t i{ 0 }; i < dump.currentValues.size(); ++i)
+	{
+		uint8_t value{ 0 };
+		file.read(reinterpret_cast<char*>(&value), sizeof(value));
+		dump.currentValues[i] = value != 0;
+	}
+
+	dump.records.resize(dump.header.recordCount);
+	if (!dump.records.empty())
+		file.read(reinterpret_cast<char*>(dump.records.data()), dump.records.size() * sizeof(Record));
+
+	return bool(file);
+}
+
+// Changes are only recorded when a value flips, walking back from the current values gives the values before the oldest record
+std::vector<bool> RebuildInitialValues(const HistoryDump& dump)
+{
+	std::vector<bool> values{ dump.currentValues };
+	for (auto it = dump.records.rbegin(); it != dump.records.rend(); ++it)
+	{
+		if (it->type == RecordType::STATE_CHANGE && it->stateIndex < values.size())
+			values[it->stateIndex] = it->value == 0;
+	}
+	return values;
+}
+
+const std::string& StateName(const HistoryDump& dump, uint16_t index)
+{
+	static const std::string unknown{ "<unknown>" };
+	return index < dump.stateNames.size() ? dump.stateNames[index] : unknown;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		printf("Usage: %s <history file> [--timeline]\n", argv[0]);
+		return 1;
+	}
+
+	HistoryDump dump{};
+	if (!LoadDump(argv[1], dump))
+	{
+		printf("Failed to read history file %s\n", argv[1]);
+		return 1;
+	}
+
+	bool printTimeline = argc > 2 && std::string{ argv[2] } == "--timeline";
+	std::vector<bool> values = RebuildInitialValues(dump);
+
+	printf("%u records, %u dropped by the ring buffer, %u states\n", dump.header.recordCount, dump.header.droppedRecords, dump.header.stateCount);
+	printf("Initial values:\n");
+	for (size_t i{ 0 }; i < values.size(); ++i)
+	{
+		printf("  %s = %d\n", dump.stateNames[i].c_str(), int(values[i]));
+	}
+
+	// Correlate every planner call with the changes since the previous one
+	std::map<std::string, int> changesBeforeReplan{};
+	std::vector<uint16_t> changedSinceLastPlan{};
+	std::vector<uint32_t> planFrames{};
+	for (const Record& record : dump.records)
+	{
+		if (record.type == RecordType::STATE_CHANGE)
+		{
+			if (record.stateIndex < values.size())
+				values[record.stateIndex] = record.value != 0;
+			if (std::find(changedSinceLastPlan.begin(), changedSinceLastPlan.end(), record.stateIndex) == changedSinceLastPlan.end())
+				changedSinceLastPlan.push_back(record.stateIndex);
+
+			if (printTimeline)
+				printf("[%8u] %s -> %d\n", record.frame, StateName(dump, record.stateIndex).c_str(), int(record.value));
+		}
+		else if (record.type == RecordType::PLANNER_CALL)
+		{
+			if (printTimeline)
+			{
+				printf("[%8u] PLAN (%d actions) after changes to:", record.frame, int(record.value));
+				for (uint16_t index : changedSinceLastPlan)
+				{
+					printf(" %s", StateName(dump, index).c_str());
+				}
+				printf("\n");
+			}
+
+			for (uint16_t index : changedSinceLastPlan)
+			{
+				++changesBeforeReplan[StateName(dump, index)];
+			}
+			if (changedSinceLastPlan.empty())
+				++changesBeforeReplan["<no change>"];
+
+			changedSinceLastPlan.clear();
+			planFrames.push_back(record.frame);
+		}
+	}
+
+	printf("\n%zu planner calls\n", planFrames.size());
+	if (planFrames.size() > 1)
+	{
+		float averageInterval = float(planFrames.back() - planFrames.front()) / float(planFrames.size() - 1);
+		printf("Average interval: %.2f frames\n", averageInterval);
+	}
+
+	std::vector<std::pair<std::string, int>> ranking{ changesBeforeReplan.begin(), changesBeforeReplan.end() };
+	std::sort(ranking.begin(), ranking.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+	printf("States changed before a replan:\n");
+	for (const auto& entry : ranking)
+	{
+		printf("  %-24s %d\n", entry.first.c_str(), entry.second);
+	}
+
+	return 0;
+}
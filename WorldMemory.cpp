@@ -0,0 +1,417 @@
+#include "stdafx.h"
+#include "WorldMemory.h"
+#include "utils.h"
+#include "ConfigManager.h"
+
+WorldMemory::WorldMemory(float cellSize, const WorldInfo& worldInfo) :
+	m_Quantizer(worldInfo.Center, worldInfo.Dimensions),
+	m_Items(cellSize, m_Quantizer),
+	m_CornerGrid(cellSize),
+	m_PurgeZoneGrid(cellSize)
+{
+}
+
+void WorldMemory::Update(float deltaTime, const Elite::Vector2& agentPosition)
+{
+	m_Time += deltaTime;
+	m_AgentPosition = agentPosition;
+
+	float reportInterval = ConfigManager::GetInstance()->GetWorldMemoryReportInterval();
+	m_ReportTimer += deltaTime;
+	if (reportInterval > 0.f && m_ReportTimer >= reportInterval)
+	{
+		Report();
+		m_ReportTimer = 0.f;
+	}
+}
+
+size_t WorldMemory::GetMemoryFootprint() const
+{
+	return m_Items.GetMemoryFootprint()
+		+ m_HouseCenters.capacity() * sizeof(QuantizedPosition) + m_HouseSizes.capacity() * sizeof(QuantizedPosition)
+		+ m_HouseBounds.GetMemoryFootprint() + m_HouseRevisitEpochs.capacity() * sizeof(uint32_t) + m_HouseRevisitSlots.capacity() * sizeof(uint32_t)
+		+ m_RevisitQueue.size() * sizeof(std::pair<uint32_t, uint32_t>)
+		+ m_RevisitHouses.capacity() * sizeof(uint32_t) + m_RevisitCenters.capacity() * sizeof(Elite::Vector2)
+		+ m_Corners.capacity() * sizeof(QuantizedPosition) + m_CornerGrid.GetMemoryFootprint()
+		+ m_PurgeZoneCenters.capacity() * sizeof(QuantizedPosition) + m_PurgeZoneRadii.capacity() * sizeof(uint16_t)
+		+ m_PurgeZoneAges.capacity() * sizeof(float) + m_PurgeZoneGrid.GetMemoryFootprint()
+		+ (m_QueryResult.capacity() + m_ItemQueryResult.capacity()) * sizeof(uint64_t);
+}
+
+// Items
+bool WorldMemory::AddItem(const EntityInfo& entity, eItemType type)
+{
+	if (!m_Items.Add(entity, type, m_Time).IsValid())
+		return false;
+
+	ConfigManager* pConfig = ConfigManager::GetInstance();
+	size_t maxItems = pConfig->GetMaxRememberedItems();
+	while (maxItems > 0 && m_Items.GetCount() > maxItems)
+	{
+		m_Items.Remove(m_Items.FindEvictionCandidate(m_AgentPosition, pConfig->GetItemEvictionWindow()));
+		++m_EvictedItems;
+	}
+	return true;
+}
+
+void WorldMemory::ForgetUnseenItems(const AgentInfo& agentInfo)
+{
+	// Only well inside the FOV, items on its edge flicker in and out of view
+	const float fovScale{ .8f };
+	float range = agentInfo.FOV_Range * fovScale;
+	float minCosine = cosf(agentInfo.FOV_Angle / 2.f * fovScale);
+	Elite::Vector2 forward{ cosf(agentInfo.Orientation - b2_pi / 2.f), sinf(agentInfo.Orientation - b2_pi / 2.f) };
+
+	m_ItemQueryResult.clear();
+	m_Items.Query(agentInfo.Position, range, m_ItemQueryResult);
+	for (ItemHandle handle : m_ItemQueryResult)
+	{
+		if (m_Items.GetLastSeen(handle) >= m_Time)
+			continue;
+
+		RememberedItem item{};
+		m_Items.Get(handle, item);
+		Elite::Vector2 toItem = item.entity.Location - agentInfo.Position;
+		float distance = toItem.Magnitude();
+		if (distance > 0.f && (toItem.x * forward.x + toItem.y * forward.y) / distance >= minCosine)
+		{
+			m_Items.Remove(handle);
+			++m_ForgottenItems;
+		}
+	}
+}
+
+void WorldMemory::QueryItems(const Elite::Vector2& center, float radius, std::vector<ItemHandle>& handles, uint32_t typeMask) const
+{
+	m_Items.Query(center, radius, handles, typeMask);
+}
+
+void WorldMemory::RemoveItems(const std::vector<ItemHandle>& handles)
+{
+	for (ItemHandle handle : handles)
+	{
+		m_Items.Remove(handle);
+	}
+}
+
+// Houses
+bool WorldMemory::AddHouse(const HouseInfo& houseInfo)
+{
+	QuantizedPosition center = m_Quantizer.Encode(houseInfo.Center);
+	QuantizedPosition size{ m_Quantizer.EncodeLength(houseInfo.Size.x), m_Quantizer.EncodeLength(houseInfo.Size.y) };
+	if (std::find(m_HouseCenters.begin(), m_HouseCenters.end(), center) != m_HouseCenters.end())
+		return false;
+
+	size_t maxHouses = ConfigManager::GetInstance()->GetMaxRememberedHouses();
+	if (maxHouses > 0 && m_HouseCenters.size() >= maxHouses)
+	{
+		// Replace the furthest house, the one the agent is in keeps its index
+		int agentHouse = FindHouseContaining(m_AgentPosition, 1.f);
+		int furthestHouse{ -1 };
+		float furthestDistanceSq{ -1.f };
+		for (int i{ 0 }; i < static_cast<int>(m_HouseCenters.size()); ++i)
+		{
+			float distanceSq = m_AgentPosition.DistanceSquared(m_Quantizer.Decode(m_HouseCenters[i]));
+			if (i != agentHouse && distanceSq > furthestDistanceSq)
+			{
+				furthestDistanceSq = distanceSq;
+				furthestHouse = i;
+			}
+		}
+
+		if (furthestHouse < 0)
+			return false;
+
+		// Out of the revisit list while its center is still the old one, then back in right away
+		SetHouseRevisitable(static_cast<uint32_t>(furthestHouse), false);
+		m_HouseCenters[furthestHouse] = center;
+		m_HouseSizes[furthestHouse] = size;
+		MarkHouseForRevisit(furthestHouse);
+		HouseInfo decodedHouse = GetHouse(furthestHouse);
+		m_HouseBounds.Set(static_cast<uint32_t>(furthestHouse), decodedHouse.Center, decodedHouse.Size);
+		++m_EvictedHouses;
+		return true;
+	}
+
+	// Worth a visit right away
+	int index = static_cast<int>(m_HouseCenters.size());
+	m_HouseCenters.push_back(center);
+	m_HouseSizes.push_back(size);
+	m_HouseRevisitEpochs.push_back(m_LootEpoch);
+	m_HouseRevisitSlots.push_back(UINT32_MAX);
+	MarkHouseForRevisit(index);
+	HouseInfo decodedHouse = GetHouse(index);
+	m_HouseBounds.Set(static_cast<uint32_t>(index), decodedHouse.Center, decodedHouse.Size);
+	return true;
+}
+
+HouseInfo WorldMemory::GetHouse(int index) const
+{
+	const QuantizedPosition& size = m_HouseSizes[index];
+	return HouseInfo{ m_Quantizer.Decode(m_HouseCenters[index]),
+		Elite::Vector2{ m_Quantizer.DecodeLength(size.x), m_Quantizer.DecodeLength(size.y) } };
+}
+
+void WorldMemory::MarkHouseExplored(int index, int lootsBeforeRevisit)
+{
+	// Called every frame the agent is in the house, only queue it again once the epoch moved on
+	uint32_t revisitEpoch = m_LootEpoch + static_cast<uint32_t>(std::max(lootsBeforeRevisit, 0)) + 1;
+	if (m_HouseRevisitSlots[index] == UINT32_MAX && m_HouseRevisitEpochs[index] == revisitEpoch)
+		return;
+
+	SetHouseRevisitable(static_cast<uint32_t>(index), false);
+	m_HouseRevisitEpochs[index] = revisitEpoch;
+	m_RevisitQueue.emplace(revisitEpoch, static_cast<uint32_t>(index));
+
+	// Drop the outdated entries once they outnumber the houses
+	const size_t maxQueueSizePerHouse{ 4 };
+	if (m_RevisitQueue.size() > maxQueueSizePerHouse * m_HouseCenters.size())
+	{
+		std::vector<std::pair<uint32_t, uint32_t>> entries{};
+		entries.reserve(m_HouseCenters.size());
+		while (!m_RevisitQueue.empty())
+		{
+			const std::pair<uint32_t, uint32_t>& entry = m_RevisitQueue.top();
+			if (m_HouseRevisitSlots[entry.second] == UINT32_MAX && m_HouseRevisitEpochs[entry.second] == entry.first)
+				entries.push_back(entry);
+			m_RevisitQueue.pop();
+		}
+		for (const std::pair<uint32_t, uint32_t>& entry : entries)
+		{
+			m_RevisitQueue.push(entry);
+		}
+	}
+}
+
+void WorldMemory::MarkHouseForRevisit(int index)
+{
+	m_HouseRevisitEpochs[index] = m_LootEpoch;
+	SetHouseRevisitable(static_cast<uint32_t>(index), true);
+}
+
+int WorldMemory::FindHouseContaining(const Elite::Vector2& point, float margin, int hint) const
+{
+	return m_HouseBounds.FindContaining(point, margin, hint);
+}
+
+void WorldMemory::FindHousesContaining(const std::vector<Elite::Vector2>& points, float margin, std::vector<int>& houses) const
+{
+	m_HouseBounds.FindContaining(points, margin, houses);
+}
+
+int WorldMemory::FindNearestHouseToRevisit(const Elite::Vector2& position)
+{
+	UpdateRevisitSchedule();
+
+	// The purge zone test is the expensive part, only closer houses get it
+	int closestHouse{ -1 };
+	float closestDistanceSq{ FLT_MAX };
+	for (size_t i{ 0 }; i < m_RevisitHouses.size(); ++i)
+	{
+		float distanceSq = position.DistanceSquared(m_RevisitCenters[i]);
+		if (distanceSq < closestDistanceSq && !IsInPurgeZone(m_RevisitCenters[i]))
+		{
+			closestDistanceSq = distanceSq;
+			closestHouse = static_cast<int>(m_RevisitHouses[i]);
+		}
+	}
+	return closestHouse;
+}
+
+void WorldMemory::UpdateRevisitSchedule()
+{
+	while (!m_RevisitQueue.empty() && m_RevisitQueue.top().first <= m_LootEpoch)
+	{
+		std::pair<uint32_t, uint32_t> entry = m_RevisitQueue.top();
+		m_RevisitQueue.pop();
+		if (m_HouseRevisitSlots[entry.second] == UINT32_MAX && m_HouseRevisitEpochs[entry.second] == entry.first)
+			SetHouseRevisitable(entry.second, true);
+	}
+}
+
+void WorldMemory::SetHouseRevisitable(uint32_t index, bool revisitable)
+{
+	uint32_t slot = m_HouseRevisitSlots[index];
+	if ((slot != UINT32_MAX) == revisitable)
+		return;
+
+	++m_Revision;
+	if (revisitable)
+	{
+		m_HouseRevisitSlots[index] = static_cast<uint32_t>(m_RevisitHouses.size());
+		m_RevisitHouses.push_back(index);
+		m_RevisitCenters.push_back(m_Quantizer.Decode(m_HouseCenters[index]));
+		return;
+	}
+
+	// Swap and pop
+	uint32_t lastHouse = m_RevisitHouses.back();
+	m_RevisitHouses[slot] = lastHouse;
+	m_RevisitCenters[slot] = m_RevisitCenters.back();
+	m_HouseRevisitSlots[lastHouse] = slot;
+	m_RevisitHouses.pop_back();
+	m_RevisitCenters.pop_back();
+	m_HouseRevisitSlots[index] = UINT32_MAX;
+}
+
+// House corners
+void WorldMemory::AddCorner(const Elite::Vector2& corner)
+{
+	QuantizedPosition quantizedCorner = m_Quantizer.Encode(corner);
+	Elite::Vector2 decodedCorner = m_Quantizer.Decode(quantizedCorner);
+
+	size_t maxCorners = ConfigManager::GetInstance()->GetMaxRememberedCorners();
+	if (maxCorners > 0 && m_Corners.size() >= maxCorners)
+	{
+		// Only happens when a scout commits, a linear search is fine
+		uint32_t furthestCorner{ 0 };
+		float furthestDistanceSq{ -1.f };
+		for (uint32_t i{ 0 }; i < m_Corners.size(); ++i)
+		{
+			float distanceSq = m_AgentPosition.DistanceSquared(GetCorner(i));
+			if (distanceSq > furthestDistanceSq)
+			{
+				furthestDistanceSq = distanceSq;
+				furthestCorner = i;
+			}
+		}
+
+		++m_EvictedCorners;
+		if (m_AgentPosition.DistanceSquared(decodedCorner) >= furthestDistanceSq)
+			return;
+		RemoveAt(m_CornerGrid, m_Corners, furthestCorner, m_Corners);
+	}
+
+	m_CornerGrid.Insert(static_cast<uint32_t>(m_Corners.size()), decodedCorner);
+	m_Corners.push_back(quantizedCorner);
+	++m_Revision;
+}
+
+void WorldMemory::RemoveCornersNearHouse(const HouseInfo& houseInfo, float margin)
+{
+	// Tests every corner straight from the quantized array, that's cheaper than a grid query for a few hundred corners
+	m_QueryResult.clear();
+	HouseBoundsTable::FindPointsInHouse(m_Corners, m_Quantizer, houseInfo.Center, houseInfo.Size, -margin, m_QueryResult);
+
+	// Highest index first, so swap and pop never moves a corner that still has to be checked
+	for (auto it = m_QueryResult.rbegin(); it != m_QueryResult.rend(); ++it)
+	{
+		RemoveAt(m_CornerGrid, m_Corners, *it, m_Corners);
+	}
+}
+
+bool WorldMemory::FindNearestCorner(const Elite::Vector2& position, Elite::Vector2& corner) const
+{
+	uint32_t index{};
+	if (!m_CornerGrid.FindNearest(position, [this](uint32_t i) { return !IsInPurgeZone(GetCorner(i)); }, index))
+		return false;
+
+	corner = GetCorner(index);
+	return true;
+}
+
+// Purge zones
+bool WorldMemory::AddPurgeZone(const PurgeZoneInfo& purgeZoneInfo)
+{
+	QuantizedPosition center = m_Quantizer.Encode(purgeZoneInfo.Center);
+	Elite::Vector2 decodedCenter = m_Quantizer.Decode(center);
+
+	m_QueryResult.clear();
+	m_PurgeZoneGrid.QueryRadius(decodedCenter, 0.f, m_QueryResult);
+	for (uint32_t index : m_QueryResult)
+	{
+		if (m_PurgeZoneCenters[index] == center)
+			return false;
+	}
+
+	m_PurgeZoneGrid.Insert(static_cast<uint32_t>(m_PurgeZoneCenters.size()), decodedCenter);
+	m_PurgeZoneCenters.push_back(center);
+	m_PurgeZoneRadii.push_back(m_Quantizer.EncodeLength(purgeZoneInfo.Radius));
+	m_PurgeZoneAges.push_back(0.f);
+	m_MaxPurgeZoneRadius = std::max(m_MaxPurgeZoneRadius, m_Quantizer.DecodeLength(m_PurgeZoneRadii.back()));
+	++m_Revision;
+	return true;
+}
+
+void WorldMemory::UpdatePurgeZones(float deltaTime, float maxAge)
+{
+	// Backwards, so swap and pop only moves zones that were already checked
+	for (size_t i{ m_PurgeZoneAges.size() }; i > 0; --i)
+	{
+		uint32_t index = static_cast<uint32_t>(i - 1);
+		if (m_PurgeZoneAges[index] > maxAge)
+			RemoveAt(m_PurgeZoneGrid, m_PurgeZoneCenters, index, m_PurgeZoneCenters, m_PurgeZoneRadii, m_PurgeZoneAges);
+		else
+			m_PurgeZoneAges[index] += deltaTime;
+	}
+}
+
+bool WorldMemory::IsInPurgeZone(const Elite::Vector2& point) const
+{
+	if (m_PurgeZoneCenters.empty())
+		return false;
+
+	// Own buffer, this is called from inside the other queries
+	thread_local std::vector<uint32_t> zonesInRange{};
+	zonesInRange.clear();
+	m_PurgeZoneGrid.QueryRadius(point, m_MaxPurgeZoneRadius, zonesInRange);
+	for (uint32_t index : zonesInRange)
+	{
+		if (utils::IsPointInCircle(point, m_Quantizer.Decode(m_PurgeZoneCenters[index]), m_Quantizer.DecodeLength(m_PurgeZoneRadii[index])))
+			return true;
+	}
+	return false;
+}
+
+PurgeZoneInfo WorldMemory::GetPurgeZone(uint32_t index) const
+{
+	PurgeZoneInfo purgeZoneInfo{};
+	purgeZoneInfo.Center = m_Quantizer.Decode(m_PurgeZoneCenters[index]);
+	purgeZoneInfo.Radius = m_Quantizer.DecodeLength(m_PurgeZoneRadii[index]);
+	return purgeZoneInfo;
+}
+
+void WorldMemory::Report()
+{
+	if (!DebugOutputManager::GetInstance()->IsDebugTypeEnabled(DebugOutputManager::DebugType::MEMORY))
+		return;
+
+	char line[256];
+	snprintf(line, sizeof(line), "World memory: %zu bytes\n", GetMemoryFootprint());
+	DebugOutputManager::GetInstance()->DebugLine(line, DebugOutputManager::DebugType::MEMORY);
+
+	// Compared to the records before quantization: a std::list of EntityInfo, ExploredHouse, Vector2 and SpottedPurgeZone
+	ReportCategory("Items", m_Items.GetCount(), ItemMemory::GetRecordSize(), sizeof(EntityInfo) + 2 * sizeof(void*));
+	ReportCategory("Houses", m_HouseCenters.size(), 2 * sizeof(QuantizedPosition) + 2 * sizeof(uint32_t) + 4 * sizeof(float), sizeof(ExploredHouse));
+	ReportCategory("Corners", m_Corners.size(), sizeof(QuantizedPosition), sizeof(Elite::Vector2));
+	ReportCategory("Purge zones", m_PurgeZoneCenters.size(), sizeof(QuantizedPosition) + sizeof(uint16_t) + sizeof(float), sizeof(SpottedPurgeZone));
+
+	snprintf(line, sizeof(line), "Evicted %u items, %u houses, %u corners, forgot %u unseen items\n",
+		m_EvictedItems, m_EvictedHouses, m_EvictedCorners, m_ForgottenItems);
+	DebugOutputManager::GetInstance()->DebugLine(line, DebugOutputManager::DebugType::MEMORY);
+
+	m_EvictedItems = m_ForgottenItems = m_EvictedHouses = m_EvictedCorners = 0;
+}
+
+void WorldMemory::ReportCategory(const char* name, size_t count, size_t recordSize, size_t legacyRecordSize) const
+{
+	char line[256];
+	snprintf(line, sizeof(line), "%s: %zu records, %zu bytes, %zu bytes in the old layout\n",
+		name, count, count * recordSize, count * legacyRecordSize);
+	DebugOutputManager::GetInstance()->DebugLine(line, DebugOutputManager::DebugType::MEMORY);
+}
+
+template<typename... Arrays>
+void WorldMemory::RemoveAt(SpatialGrid& grid, const std::vector<QuantizedPosition>& positions, uint32_t index, Arrays&... arrays)
+{
+	++m_Revision;
+	uint32_t lastIndex = static_cast<uint32_t>(positions.size() - 1);
+	grid.Remove(index, m_Quantizer.Decode(positions[index]));
+	if (index != lastIndex)
+	{
+		grid.Remove(lastIndex, m_Quantizer.Decode(positions[lastIndex]));
+		grid.Insert(index, m_Quantizer.Decode(positions[lastIndex]));
+		((arrays[index] = arrays[lastIndex]), ...);
+	}
+	(arrays.pop_back(), ...);
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "structs.h"
+#include "SpatialGrid.h"
+#include "ItemMemory.h"
+#include "PositionQuantizer.h"
+#include "HouseBoundsTable.h"
+
+// Everything the agent remembers about the world: items on the ground, explored houses, house corners
+// found by scouting and recently spotted purge zones. Items, corners and purge zones are indexed by a SpatialGrid so
+// lookups only touch the cells around the query instead of every record, items live in an ItemMemory
+// There are few houses, their bounds are tested all at once by a HouseBoundsTable instead
+// Every category has a cap from the ConfigManager, the least valuable records are evicted to stay under it
+// Records are stored as structures of arrays with positions quantized to 16 bits over the world bounds
+class WorldMemory final
+{
+public:
+	WorldMemory(float cellSize, const WorldInfo& worldInfo);
+
+	// Advances the memory clock, call once per frame before anything is added
+	void Update(float deltaTime, const Elite::Vector2& agentPosition);
+	// Bytes held by every category
+	size_t GetMemoryFootprint() const;
+	// Goes up whenever a record is added, removed or changes whether it is worth a visit
+	uint32_t GetRevision() const { return m_Revision + m_Items.GetRevision(); };
+	const PositionQuantizer& GetQuantizer() const { return m_Quantizer; };
+
+	// Items
+	// Returns false if an item at that location is already known, that item is marked as seen instead
+	// Over the cap the furthest of the least recently seen items is evicted
+	bool AddItem(const EntityInfo& entity, eItemType type);
+	// Forgets the items well inside the FOV that weren't seen this frame, someone else looted them
+	void ForgetUnseenItems(const AgentInfo& agentInfo);
+	size_t GetItemCount() const { return m_Items.GetCount(); };
+	// Returns false if the item was removed
+	bool GetItem(ItemHandle handle, RememberedItem& item) const { return m_Items.Get(handle, item); };
+	// Appends the handles of the items of the masked types within the radius
+	void QueryItems(const Elite::Vector2& center, float radius, std::vector<ItemHandle>& handles, uint32_t typeMask = ItemMemory::AllTypes) const;
+	void RemoveItems(const std::vector<ItemHandle>& handles);
+	// Quantized records for bulk passes
+	const ItemMemory& GetItems() const { return m_Items; };
+
+	// Houses, an evicted house is replaced in place so the indices of the others stay valid
+	// Returns false if the house is already known. Over the cap it replaces the furthest house the agent isn't in
+	bool AddHouse(const HouseInfo& houseInfo);
+	size_t GetHouseCount() const { return m_HouseCenters.size(); };
+	HouseInfo GetHouse(int index) const;
+	// The agent was in the house, it's only worth a revisit once more than the given amount of items were looted
+	void MarkHouseExplored(int index, int lootsBeforeRevisit);
+	// Makes the house worth a revisit right away
+	void MarkHouseForRevisit(int index);
+	// Index of the house the point is in, -1 if it isn't in any. The margin works like utils::IsPointInRect
+	// The hint is tested first, pass the house the point was in last frame
+	int FindHouseContaining(const Elite::Vector2& point, float margin, int hint = -1) const;
+	// Index of the house every point is in, -1 for the points that aren't in any
+	void FindHousesContaining(const std::vector<Elite::Vector2>& points, float margin, std::vector<int>& houses) const;
+	// Closest house outside of the known purge zones that is worth a revisit, -1 if there is none
+	int FindNearestHouseToRevisit(const Elite::Vector2& position);
+	void OnItemLooted() { ++m_LootEpoch; };
+	// Moves the houses whose epoch came to the revisit list, the revisit list is up to date after this
+	void UpdateRevisitSchedule();
+	// Houses worth a revisit, and their centers in the same order
+	const std::vector<uint32_t>& GetRevisitHouses() const { return m_RevisitHouses; };
+	const std::vector<Elite::Vector2>& GetRevisitCenters() const { return m_RevisitCenters; };
+
+	// House corners
+	// Over the cap the furthest corner is dropped, which can be the new one
+	void AddCorner(const Elite::Vector2& corner);
+	size_t GetCornerCount() const { return m_Corners.size(); };
+	Elite::Vector2 GetCorner(uint32_t index) const { return m_Quantizer.Decode(m_Corners[index]); };
+	const std::vector<QuantizedPosition>& GetCorners() const { return m_Corners; };
+	// Forgets the corners within the margin around the house
+	void RemoveCornersNearHouse(const HouseInfo& houseInfo, float margin);
+	// Closest corner outside of the known purge zones, returns false if there is none
+	bool FindNearestCorner(const Elite::Vector2& position, Elite::Vector2& corner) const;
+
+	// Purge zones
+	// Returns false if the zone is already known
+	bool AddPurgeZone(const PurgeZoneInfo& purgeZoneInfo);
+	// Forgets the zones spotted longer than maxAge ago and ages the others
+	void UpdatePurgeZones(float deltaTime, float maxAge);
+	bool IsInPurgeZone(const Elite::Vector2& point) const;
+	size_t GetPurgeZoneCount() const { return m_PurgeZoneCenters.size(); };
+	PurgeZoneInfo GetPurgeZone(uint32_t index) const;
+private:
+	PositionQuantizer m_Quantizer;
+	ItemMemory m_Items;
+
+	// Houses, the sizes are quantized lengths
+	std::vector<QuantizedPosition> m_HouseCenters{};
+	std::vector<QuantizedPosition> m_HouseSizes{};
+	HouseBoundsTable m_HouseBounds{}; // At the decoded centers and sizes
+
+	// Revisits are scheduled in loot epochs, the epoch goes up by one for every looted item
+	// A house waits in the heap until its epoch comes, then moves to the dense list of houses worth a revisit
+	uint32_t m_LootEpoch{ 0 };
+	std::vector<uint32_t> m_HouseRevisitEpochs{};
+	std::vector<uint32_t> m_HouseRevisitSlots{}; // Position in the revisit list, UINT32_MAX if the house isn't in it
+	// Pairs of epoch and house, entries whose epoch no longer matches the house's are skipped
+	std::priority_queue<std::pair<uint32_t, uint32_t>, std::vector<std::pair<uint32_t, uint32_t>>, std::greater<>> m_RevisitQueue{};
+	// Houses worth a revisit and their decoded centers, usually a handful so the nearest one is a short scan
+	std::vector<uint32_t> m_RevisitHouses{};
+	std::vector<Elite::Vector2> m_RevisitCenters{};
+	std::vector<QuantizedPosition> m_Corners{};
+	// Purge zones
+	std::vector<QuantizedPosition> m_PurgeZoneCenters{};
+	std::vector<uint16_t> m_PurgeZoneRadii{};
+	std::vector<float> m_PurgeZoneAges{};
+
+	// Indexed by position in the arrays above, at the decoded positions
+	SpatialGrid m_CornerGrid;
+	SpatialGrid m_PurgeZoneGrid; // Centers
+
+	// Purge zones are indexed by their center, queries are widened by the largest radius
+	float m_MaxPurgeZoneRadius{ 0.f };
+
+	// Reused query output
+	mutable std::vector<uint32_t> m_QueryResult{};
+	std::vector<ItemHandle> m_ItemQueryResult{};
+
+	float m_Time{ 0.f };
+	uint32_t m_Revision{ 0 }; // Houses, corners and purge zones, the items keep their own
+	Elite::Vector2 m_AgentPosition{};
+
+	// Eviction counters since the last report
+	uint32_t m_EvictedItems{ 0 };
+	uint32_t m_ForgottenItems{ 0 };
+	uint32_t m_EvictedHouses{ 0 };
+	uint32_t m_EvictedCorners{ 0 };
+	float m_ReportTimer{ 0.f };
+
+	void SetHouseRevisitable(uint32_t index, bool revisitable);
+
+	void Report();
+	void ReportCategory(const char* name, size_t count, size_t recordSize, size_t legacyRecordSize) const;
+
+	// Swap and pop over every array of a category, moves the last record into the gap and updates its grid entry
+	// The positions have to be one of the arrays
+	template<typename... Arrays>
+	void RemoveAt(SpatialGrid& grid, const std::vector<QuantizedPosition>& positions, uint32_t index, Arrays&... arrays);
+};
@@ -1,2 +1,183 @@
 #include "stdafx.h"
 #include "WorldState.h"
+#include "WorldStateHistory.h"
+
+WorldState::WorldState() :
+	m_pKeys{ std::make_shared<KeyTable>() },
+	m_pValues{ std::make_shared<std::vector<bool>>() }
+{
+}
+
+void WorldState::AddState(const std::string& key, bool value)
+{
+	auto it = m_pKeys->find(key);
+	if (it == m_pKeys->end())
+	{
+		DebugOutputManager::GetInstance()->DebugLine("Adding state: " + key + " \n",
+			DebugOutputManager::DebugType::WORLDSTATE);
+		DetachKeys();
+		DetachValues();
+		(*m_pKeys)[key] = static_cast<int>(m_pValues->size());
+		m_pValues->push_back(value);
+		return;
+	}
+	DebugOutputManager::GetInstance()->DebugLine("ERROR: State " + key + " already exists\n",
+		DebugOutputManager::DebugType::PROBLEM);
+}
+
+void WorldState::SetState(const std::string& key, bool newValue)
+{
+	auto it = m_pKeys->find(key);
+	if (it != m_pKeys->end())
+	{
+		SetState(it->second, newValue);
+	}
+}
+
+void WorldState::SetState(int index, bool newValue)
+{
+	if (index < 0 || index >= static_cast<int>(m_pValues->size()))
+		return;
+
+	bool oldValue = (*m_pValues)[index];
+	if (oldValue == newValue)
+		return;
+
+	// Only journal while someone can still roll back
+	if (!m_OpenSnapshots.empty())
+		m_Journal.push_back(JournalEntry{ index, oldValue });
+
+	DetachValues();
+	(*m_pValues)[index] = newValue;
+
+	if (m_pHistory)
+		m_pHistory->RecordStateChange(index, newValue);
+}
+
+bool WorldState::GetState(const std::string& key, bool& value) const
+{
+	auto it = m_pKeys->find(key);
+	if (it != m_pKeys->end())
+	{
+		value = (*m_pValues)[it->second];
+		return true;
+	}
+	return false;
+}
+
+bool WorldState::IsStateMet(const std::string& key, const bool value) const
+{
+	auto it = m_pKeys->find(key);
+	if (it != m_pKeys->end())
+		return (*m_pValues)[it->second] == value;
+	return false;
+}
+
+bool WorldState::IsStateMet(int index, const bool value) const
+{
+	if (index < 0 || index >= static_cast<int>(m_pValues->size()))
+		return false;
+	return (*m_pValues)[index] == value;
+}
+
+bool WorldState::DoesStateExist(const std::string& key) const
+{
+	return m_pKeys->find(key) != m_pKeys->end();
+}
+
+int WorldState::GetStateIndex(const std::string& key) const
+{
+	auto it = m_pKeys->find(key);
+	if (it != m_pKeys->end())
+		return it->second;
+	return -1;
+}
+
+std::vector<std::string> WorldState::GetStateNames() const
+{
+	std::vector<std::string> names(m_pValues->size());
+	for (const auto& key : *m_pKeys)
+	{
+		names[key.second] = key.first;
+	}
+	return names;
+}
+
+WorldState WorldState::Fork() const
+{
+	// Copying only shares the key table and the values, the journal belongs to this state
+	WorldState fork{ *this };
+	fork.m_Journal.clear();
+	fork.m_OpenSnapshots.clear();
+	fork.m_pHistory = nullptr;
+	return fork;
+}
+
+WorldState::Snapshot WorldState::TakeSnapshot()
+{
+	m_OpenSnapshots.push_back(m_Journal.size());
+	return Snapshot{ m_Journal.size() };
+}
+
+void WorldState::RestoreSnapshot(const Snapshot& snapshot)
+{
+	// Rolling back past an inner snapshot would leave it pointing beyond the journal
+	if (!IsInnermostSnapshot(snapshot, "Restoring"))
+		return;
+
+	if (m_Journal.size() <= snapshot.journalSize)
+		return;
+
+	DetachValues();
+	// Undo in reverse order so a state written multiple times ends up at its oldest value
+	while (m_Journal.size() > snapshot.journalSize)
+	{
+		const JournalEntry& entry = m_Journal.back();
+		(*m_pValues)[entry.index] = entry.oldValue;
+		if (m_pHistory)
+			m_pHistory->RecordStateChange(entry.index, entry.oldValue);
+		m_Journal.pop_back();
+	}
+}
+
+void WorldState::ReleaseSnapshot(const Snapshot& snapshot)
+{
+	if (!IsInnermostSnapshot(snapshot, "Releasing"))
+		return;
+
+	m_OpenSnapshots.pop_back();
+	// Nothing can roll back anymore, drop the journal
+	if (m_OpenSnapshots.empty())
+		m_Journal.clear();
+}
+
+bool WorldState::IsInnermostSnapshot(const Snapshot& snapshot, const std::string& operation) const
+{
+	if (m_OpenSnapshots.empty())
+	{
+		DebugOutputManager::GetInstance()->DebugLine("ERROR: " + operation + " a WorldState snapshot that was never taken\n",
+			DebugOutputManager::DebugType::PROBLEM);
+		return false;
+	}
+
+	if (m_OpenSnapshots.back() != snapshot.journalSize)
+	{
+		DebugOutputManager::GetInstance()->DebugLine("ERROR: " + operation + " a WorldState snapshot out of order, snapshot at "
+			+ std::to_string(snapshot.journalSize) + " but the innermost is at " + std::to_string(m_OpenSnapshots.back()) + "\n",
+			DebugOutputManager::DebugType::PROBLEM);
+		return false;
+	}
+	return true;
+}
+
+void WorldState::DetachKeys()
+{
+	if (m_pKeys.use_count() > 1)
+		m_pKeys = std::make_shared<KeyTable>(*m_pKeys);
+}
+
+void WorldState::DetachValues()
+{
+	if (m_pValues.use_count() > 1)
+		m_pValues = std::make_shared<std::vector<bool>>(*m_pValues);
+}
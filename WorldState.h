@@ -1,67 +1,70 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include "structs.h"
 #include "DebugOutputManager.h"
 #include <unordered_map>
 
+class WorldStateHistory;
 class WorldState
 {
 public:
-	WorldState() = default;
-
-	void AddState(const std::string& key, bool value)
+	// Marker into the undo journal, restoring it rolls back every SetState done after it was taken
+	struct Snapshot
 	{
-		auto it = m_pStates.find(key);
-		if (it == m_pStates.end())
-		{
-			DebugOutputManager::GetInstance()->DebugLine("Adding state: " + key + " \n",
-				DebugOutputManager::DebugType::WORLDSTATE);
-			m_pStates[key] = value;
-			return;
-		}
-		DebugOutputManager::GetInstance()->DebugLine("ERROR: State " + key + " already exists\n",
-			DebugOutputManager::DebugType::PROBLEM);
-		return;
-	}
+		size_t journalSize{ 0 };
+	};
 
-	void SetState(const std::string& key, bool newValue)
-	{
-		auto it = m_pStates.find(key);
-		if (it != m_pStates.end())
-		{
-			m_pStates[key] = newValue;
-		}
-	}
+	WorldState();
+
+	void AddState(const std::string& key, bool value);
+	void SetState(const std::string& key, bool newValue);
+	void SetState(int index, bool newValue);
 
 	// Returns true if the state was found, puts the value into the reference
-	bool GetState(const std::string& key, bool& value)
-	{
-		auto it = m_pStates.find(key);
-		if (it != m_pStates.end())
-		{
-			value = m_pStates[key];
-			return true;
-		}
-		return false;
-	}
+	bool GetState(const std::string& key, bool& value) const;
+	bool IsStateMet(const std::string& key, const bool value) const;
+	bool IsStateMet(int index, const bool value) const;
+	bool DoesStateExist(const std::string& key) const;
+	// Returns -1 if the state doesn't exist, the index stays valid for the lifetime of the state
+	int GetStateIndex(const std::string& key) const;
 
-	bool IsStateMet(const std::string& key, const bool value)
-	{
-		if (DoesStateExist(key))
-			return m_pStates[key] == value;
-		return false;
-	}
+	// Names and values ordered by state index
+	std::vector<std::string> GetStateNames() const;
+	const std::vector<bool>& GetValues() const { return *m_pValues; };
 
-	bool DoesStateExist(const std::string& key) const
-	{
-		auto it = m_pStates.find(key);
-		if (it != m_pStates.end())
-		{
-			return true;
-		}
-		return false;
-	}
+	// Optional change recording, the history is not owned and isn't carried over to forks
+	void SetHistory(WorldStateHistory* pHistory) { m_pHistory = pHistory; };
+	WorldStateHistory* GetHistory() const { return m_pHistory; };
+
+	// Copy-on-write fork, O(1). The fork shares keys and values with this state until either side writes
+	WorldState Fork() const;
+
+	// Undo journal, O(1) to take. Snapshots can be nested and have to be released in reverse order
+	Snapshot TakeSnapshot();
+	void RestoreSnapshot(const Snapshot& snapshot);
+	void ReleaseSnapshot(const Snapshot& snapshot);
 private:
-	std::unordered_map<std::string, bool> m_pStates{};
-};
\ No newline at end of file
+	typedef std::unordered_map<std::string, int> KeyTable;
+	struct JournalEntry
+	{
+		int index;
+		bool oldValue;
+	};
+
+	// Shared between forks, copied on the first write
+	std::shared_ptr<KeyTable> m_pKeys;
+	std::shared_ptr<std::vector<bool>> m_pValues;
+
+	std::vector<JournalEntry> m_Journal{};
+	// Journal size of every open snapshot, the innermost one is at the back
+	std::vector<size_t> m_OpenSnapshots{};
+
+	WorldStateHistory* m_pHistory = nullptr;
+
+	void DetachKeys();
+	void DetachValues();
+	// Returns false and reports the problem if the snapshot isn't the innermost open one
+	bool IsInnermostSnapshot(const Snapshot& snapshot, const std::string& operation) const;
+};
@@ -0,0 +1,65 @@
+#include "stdafx.h"
+#include "WorldStateHistory.h"
+
+using namespace WorldStateHistoryFormat;
+
+WorldStateHistory::WorldStateHistory(size_t capacity) :
+	m_Records(capacity > 0 ? capacity : 1)
+{
+}
+
+void WorldStateHistory::RecordStateChange(int stateIndex, bool newValue)
+{
+	Push(Record{ m_Frame, static_cast<uint16_t>(stateIndex), RecordType::STATE_CHANGE, static_cast<uint8_t>(newValue) });
+}
+
+void WorldStateHistory::RecordPlannerCall(size_t plannedActions)
+{
+	uint8_t actions = static_cast<uint8_t>(std::min<size_t>(plannedActions, UINT8_MAX));
+	Push(Record{ m_Frame, 0, RecordType::PLANNER_CALL, actions });
+}
+
+bool WorldStateHistory::DumpToFile(const std::string& filePath, const std::vector<std::string>& stateNames, const std::vector<bool>& currentValues) const
+{
+	std::ofstream file{ filePath, std::ios::binary | std::ios::trunc };
+	if (!file)
+		return false;
+
+	Header header{ Magic, Version, static_cast<uint32_t>(stateNames.size()), static_cast<uint32_t>(m_Count), m_Dropped };
+	file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+	for (const std::string& name : stateNames)
+	{
+		uint16_t length = static_cast<uint16_t>(name.size());
+		file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+		file.write(name.data(), length);
+	}
+
+	for (size_t i{ 0 }; i < stateNames.size(); ++i)
+	{
+		uint8_t value = i < currentValues.size() ? static_cast<uint8_t>(currentValues[i]) : 0;
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	// Oldest record first
+	size_t capacity = m_Records.size();
+	size_t start = (m_Head + capacity - m_Count) % capacity;
+	for (size_t i{ 0 }; i < m_Count; ++i)
+	{
+		const Record& record = m_Records[(start + i) % capacity];
+		file.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+	}
+
+	return file.good();
+}
+
+void WorldStateHistory::Push(const Record& record)
+{
+	m_Records[m_Head] = record;
+	m_Head = (m_Head + 1) % m_Records.size();
+
+	if (m_Count < m_Records.size())
+		++m_Count;
+	else
+		++m_Dropped;
+}
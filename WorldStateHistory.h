@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary layout of a history dump, shared with Tools/WorldStateHistoryReader.cpp
+// Header | state names (uint16 length + chars) | current values (uint8 per state) | records (oldest first)
+namespace WorldStateHistoryFormat
+{
+	const uint32_t Magic = 0x42485357; // "WSHB"
+	const uint32_t Version = 1;
+
+	enum class RecordType : uint8_t
+	{
+		STATE_CHANGE,
+		PLANNER_CALL
+	};
+
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t stateCount;
+		uint32_t recordCount;
+		uint32_t droppedRecords;
+	};
+
+	struct Record
+	{
+		uint32_t frame;
+		// STATE_CHANGE: index of the state, PLANNER_CALL: unused
+		uint16_t stateIndex;
+		RecordType type;
+		// STATE_CHANGE: new value, PLANNER_CALL: amount of planned actions
+		uint8_t value;
+	};
+}
+
+// Fixed size ring buffer of worldstate changes, never allocates after construction
+class WorldStateHistory final
+{
+public:
+	explicit WorldStateHistory(size_t capacity);
+
+	void SetFrame(uint32_t frame) { m_Frame = frame; };
+	uint32_t GetFrame() const { return m_Frame; };
+
+	void RecordStateChange(int stateIndex, bool newValue);
+	void RecordPlannerCall(size_t plannedActions);
+
+	// Writes the buffer to a binary file, the current values allow the reader to rebuild the full timeline
+	bool DumpToFile(const std::string& filePath, const std::vector<std::string>& stateNames, const std::vector<bool>& currentValues) const;
+
+	size_t GetRecordCount() const { return m_Count; };
+	uint32_t GetDroppedRecordCount() const { return m_Dropped; };
+private:
+	std::vector<WorldStateHistoryFormat::Record> m_Records;
+	size_t m_Head{ 0 }; // Next slot to write
+	size_t m_Count{ 0 };
+	uint32_t m_Dropped{ 0 };
+	uint32_t m_Frame{ 0 };
+
+	void Push(const WorldStateHistoryFormat::Record& record);
+};